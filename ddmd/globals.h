@@ -232,6 +232,14 @@ struct Param
 
     uint32_t hashThreshold; // MD5 hash symbols larger than this threshold (0 = no hashing)
 
+    uint32_t parseThreads; // number of threads to lex and parse with
+
+    bool ctfeBytecode; // use the bytecode CTFE backend where possible
+    bool cacheCtfe;    // memoize CTFE calls in the -cache directory
+    bool lazyImports;  // skip semantic2 of imported modules' initializers and static asserts
+    const char *interfaceCacheDir; // write/import module interfaces (.di) to/from this directory
+    const char *bodyDepsFile;      // write the imported bodies used for CTFE/templates/inlining to this file
+
     bool outputSourceLocations; // if true, output line tables.
 #endif
 };
@@ -21,6 +21,9 @@ struct HdrGenState
     int tpltMember;
     int autoMember;
     int forStmtInit;
+#if IN_LLVM
+    bool lineDirectives; // #line directives to the source (-interface-cache)
+#endif
 
     HdrGenState() { memset(this, 0, sizeof(HdrGenState)); }
 };
@@ -137,6 +137,7 @@ public:
     File *setOutfile(const char *name, const char *dir, const char *arg, const char *ext);
     void setDocfile();
     bool read(Loc loc); // read file, returns 'true' if succeed, 'false' otherwise.
+    void parseSource(); // lex and parse only
     Module *parse();    // syntactic parse
     void importAll(Scope *sc);
     void semantic(Scope *);    // semantic analysis
@@ -187,6 +188,11 @@ public:
 
     bool llvmForceLogging;
     bool noModuleInfo; /// Do not emit any module metadata.
+    bool hasStaticCtorOrDtor; /// Module itself defines a static ctor/dtor.
+    bool isSourceParsed; /// parseSource() has run, e.g., ahead of time.
+    /// The source file the -interface-cache interface read instead has
+    /// been generated from, used for the locations of its declarations.
+    const char *cachedInterfaceSource;
 
     // array ops emitted in this module already
     AA *arrayfuncs;
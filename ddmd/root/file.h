@@ -24,7 +24,7 @@ struct FileName;
 
 struct File
 {
-    int ref;                    // != 0 if this is a reference to someone else's buffer
+    int ref;                    // != 0 if this is a reference to someone else's buffer, 2 if it is a mapped view
     unsigned char *buffer;      // data for our file
     size_t len;                 // amount of data in buffer[]
 
@@ -42,6 +42,15 @@ struct File
 
     bool read();
 
+#if IN_LLVM
+    /* Read or map source file, return true if error
+     */
+
+    bool mmapread();
+
+    void freeBuffer();
+#endif
+
     /* Write file, return true if error
      */
 
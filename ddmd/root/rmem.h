@@ -32,6 +32,13 @@ struct Mem
     static void xfree(void *p);
     static void *xmallocdup(void *o, d_size_t size);
     static void error();
+#if IN_LLVM
+    static d_size_t arenaSize();
+    static d_size_t arenaUsed();
+    static d_size_t arenaObjects();
+    static d_size_t mallocBytes();
+    static d_size_t mallocCount();
+#endif
 };
 
 extern Mem mem;
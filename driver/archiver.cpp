@@ -9,11 +9,19 @@
 
 #include "errors.h"
 #include "globals.h"
+#include "driver/archiver.h"
 #include "driver/cl_options.h"
+#include "driver/toobj.h"
 #include "driver/tool.h"
 #include "gen/logger.h"
 #include "llvm/ADT/Triple.h"
 
+static llvm::cl::opt<bool> thinArchive(
+    "thin-lib", llvm::cl::ZeroOrMore,
+    llvm::cl::desc("Create a thin static library (-lib), only referencing the "
+                   "object files instead of embedding them (internal archiver "
+                   "only)"));
+
 #if LDC_LLVM_VER >= 309
 
 #include "llvm/Object/Archive.h"
@@ -22,6 +30,7 @@
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 
 #if LDC_LLVM_VER >= 500
@@ -71,18 +80,32 @@ void fail(Error E, std::string Context = {}) {
   });
 }
 
-int addMember(std::vector<NewArchiveMember> &Members, StringRef FileName,
-              int Pos = -1) {
+Error loadMember(StringRef FileName, NewArchiveMember &Member) {
+  // Object files emitted with -in-memory-objects haven't been written to disk.
+  if (MemoryBuffer *Buf = getInMemoryObjectFile(FileName)) {
+    Member = NewArchiveMember(Buf->getMemBufferRef());
+    return Error::success();
+  }
+
   Expected<NewArchiveMember> NMOrErr =
       NewArchiveMember::getFile(FileName, Deterministic);
-  if (auto Error = NMOrErr.takeError()) {
+  if (!NMOrErr)
+    return NMOrErr.takeError();
+  Member = std::move(*NMOrErr);
+  return Error::success();
+}
+
+int addMember(std::vector<NewArchiveMember> &Members, StringRef FileName,
+              int Pos = -1) {
+  NewArchiveMember NM;
+  if (auto Error = loadMember(FileName, NM)) {
     fail(std::move(Error), FileName);
     return 1;
   }
   if (Pos == -1)
-    Members.push_back(std::move(*NMOrErr));
+    Members.push_back(std::move(NM));
   else
-    Members[Pos] = std::move(*NMOrErr);
+    Members[Pos] = std::move(NM);
   return 0;
 }
 
@@ -141,14 +164,30 @@ int computeNewArchiveMembers(object::Archive *OldArchive,
     }
   }
 
-  const int InsertPos = Ret.size();
-  for (unsigned I = 0; I != Members.size(); ++I)
-    Ret.insert(Ret.begin() + InsertPos, NewArchiveMember());
-  int Pos = InsertPos;
-  for (auto &Member : Members) {
-    if (int Status = addMember(Ret, Member, Pos))
-      return Status;
-    ++Pos;
+  // Read the new members in parallel, as this dominates for archives with
+  // thousands of members (especially on network file systems).
+  const size_t InsertPos = Ret.size();
+  Ret.resize(InsertPos + Members.size());
+  std::vector<std::string> Errors(Members.size());
+  {
+    ThreadPool Pool;
+    for (size_t I = 0; I != Members.size(); ++I) {
+      Pool.async([&, I] {
+        if (auto Error = loadMember(Members[I], Ret[InsertPos + I])) {
+          handleAllErrors(std::move(Error), [&](const ErrorInfoBase &EIB) {
+            Errors[I] = EIB.message();
+          });
+        }
+      });
+    }
+    Pool.wait();
+  }
+
+  for (size_t I = 0; I != Members.size(); ++I) {
+    if (!Errors[I].empty()) {
+      fail(Twine(Members[I]) + ": " + Errors[I]);
+      return 1;
+    }
   }
 
   return 0;
@@ -252,6 +291,7 @@ int internalAr(ArrayRef<const char *> args) {
   }
 
   llvm_ar::ArchiveName = args[2];
+  llvm_ar::Thin = thinArchive;
 
   auto membersSlice = args.slice(3);
   llvm_ar::Members.clear();
@@ -279,6 +319,17 @@ int internalLib(ArrayRef<const char *> args) {
 static llvm::cl::opt<std::string> ar("ar", llvm::cl::desc("Archiver"),
                                      llvm::cl::Hidden, llvm::cl::ZeroOrMore);
 
+bool canArchiveFromMemory() {
+#if LDC_LLVM_VER >= 309
+  // Only the internal llvm-ar supports in-memory members, llvm-lib doesn't.
+  // Thin archives need the members on disk.
+  return ar.empty() && !thinArchive &&
+         !global.params.targetTriple->isWindowsMSVCEnvironment();
+#else
+  return false;
+#endif
+}
+
 int createStaticLibrary() {
   Logger::println("*** Creating static library ***");
 
@@ -291,6 +342,16 @@ int createStaticLibrary() {
   const bool useInternalArchiver = false;
 #endif
 
+  if (thinArchive) {
+    if (!useInternalArchiver || isTargetMSVC) {
+      error(Loc(), "-thin-lib is only supported by the internal archiver for "
+                   "non-MSVC targets");
+      return 1;
+    }
+    // The thin archive references the object files, so keep them.
+    global.params.cleanupObjectFiles = false;
+  }
+
   // find archiver
   std::string tool;
   if (useInternalArchiver) {
@@ -16,4 +16,10 @@
  */
 int createStaticLibrary();
 
+/**
+ * Returns whether createStaticLibrary() is able to take object files emitted
+ * to memory (see getInMemoryObjectFile()).
+ */
+bool canArchiveFromMemory();
+
 #endif // !LDC_DRIVER_ARCHIVER_H
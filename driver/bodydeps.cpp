@@ -0,0 +1,154 @@
+//===-- bodydeps.cpp ------------------------------------------------------===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "driver/bodydeps.h"
+
+#include "errors.h"
+#include "mars.h"
+#include "module.h"
+#include "outbuffer.h"
+#include "root.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if LDC_LLVM_VER >= 306
+using LLErrorInfo = std::error_code;
+#define ERRORINFO_STRING(errinfo) errinfo.message().c_str()
+#else
+using LLErrorInfo = std::string;
+#define ERRORINFO_STRING(errinfo) errinfo.c_str()
+#endif
+
+namespace {
+
+// (root module or null for all, kind, declaration)
+std::set<std::tuple<Module *, std::string, Dsymbol *>> dependencies;
+
+// (kind, declaration, file) replayed from cached CTFE results, for all root
+// modules
+using Replayed = std::set<std::tuple<std::string, std::string, std::string>>;
+Replayed replayed;
+
+struct Capture {
+  std::set<std::pair<std::string, Dsymbol *>> decls;
+  Replayed replayed;
+};
+
+// The active captures, innermost last
+std::vector<Capture> captures;
+
+std::string describe(Module *m) {
+  return std::string(m->toPrettyChars()) + " (" + m->srcfile->toChars() + ")";
+}
+}
+
+void bodydeps::record(Module *root, const char *kind, Dsymbol *decl) {
+  for (auto &capture : captures)
+    capture.decls.emplace(kind, decl);
+
+  if (!global.params.bodyDepsFile)
+    return;
+
+  Module *m = decl->getModule();
+  if (!m || m->isRoot())
+    return;
+
+  dependencies.emplace(root, kind, decl);
+}
+
+void bodydeps::startCapture() { captures.emplace_back(); }
+
+void bodydeps::endCapture(OutBuffer *buf) {
+  assert(!captures.empty());
+  Replayed entries = std::move(captures.back().replayed);
+  for (const auto &decl : captures.back().decls) {
+    Module *m = decl.second->getModule();
+    if (m) {
+      entries.emplace(decl.first, decl.second->toPrettyChars(),
+                      m->srcfile->toChars());
+    }
+  }
+  captures.pop_back();
+
+  for (const auto &entry : entries) {
+    const std::string line = std::get<0>(entry) + '\t' + std::get<1>(entry) +
+                             '\t' + std::get<2>(entry) + '\n';
+    buf->write(line.data(), line.size());
+  }
+}
+
+void bodydeps::replay(const char *data, size_t length) {
+  llvm::StringRef rest(data, length);
+  while (!rest.empty()) {
+    llvm::StringRef line;
+    std::tie(line, rest) = rest.split('\n');
+    llvm::StringRef kind, decl, file;
+    std::tie(kind, line) = line.split('\t');
+    std::tie(decl, file) = line.split('\t');
+    if (file.empty())
+      continue;
+
+    const auto entry = std::make_tuple(kind.str(), decl.str(), file.str());
+    for (auto &capture : captures)
+      capture.replayed.insert(entry);
+    if (global.params.bodyDepsFile)
+      replayed.insert(entry);
+  }
+}
+
+void bodydeps::write(Modules &modules) {
+  if (!global.params.bodyDepsFile)
+    return;
+
+  // Sort the lines so that the file only changes with the dependencies.
+  std::set<std::string> lines;
+  for (const auto &dep : dependencies) {
+    Dsymbol *decl = std::get<2>(dep);
+    const std::string suffix = " : " + std::get<1>(dep) + " : " +
+                               decl->toPrettyChars() + " (" +
+                               decl->getModule()->srcfile->toChars() + ")";
+    if (Module *root = std::get<0>(dep)) {
+      lines.insert(describe(root) + suffix);
+    } else {
+      for (Module *m : modules)
+        lines.insert(describe(m) + suffix);
+    }
+  }
+
+  // The replayed entries may refer to root modules.
+  std::set<std::string> rootFiles;
+  for (Module *m : modules)
+    rootFiles.insert(m->srcfile->toChars());
+  for (const auto &entry : replayed) {
+    if (rootFiles.count(std::get<2>(entry)))
+      continue;
+    const std::string suffix = " : " + std::get<0>(entry) + " : " +
+                               std::get<1>(entry) + " (" + std::get<2>(entry) +
+                               ")";
+    for (Module *m : modules)
+      lines.insert(describe(m) + suffix);
+  }
+
+  LLErrorInfo errinfo;
+  llvm::raw_fd_ostream os(global.params.bodyDepsFile, errinfo,
+                          llvm::sys::fs::F_Text);
+  if (os.has_error()) {
+    error(Loc(), "cannot write body dependencies file '%s': %s",
+          global.params.bodyDepsFile, ERRORINFO_STRING(errinfo));
+    return;
+  }
+  for (const auto &line : lines)
+    os << line << '\n';
+}
@@ -0,0 +1,53 @@
+//===-- driver/bodydeps.h - Dependencies on imported bodies -----*- C++ -*-===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Implements -body-deps, which lists the imported declarations whose bodies
+// have been used for CTFE, template instantiation, return type or attribute
+// inference or cross-module inlining.
+// A build system can skip recompiling a module if only bodies of imported
+// declarations have changed which aren't listed for it.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LDC_DRIVER_BODYDEPS_H
+#define LDC_DRIVER_BODYDEPS_H
+
+#include "arraytypes.h"
+
+class Dsymbol;
+class Module;
+struct OutBuffer;
+
+namespace bodydeps {
+
+/// Records that the body of `decl` has been used for `kind` ("ctfe",
+/// "template", "infer" or "inline") by the root module `root`, if `decl` is imported
+/// and -body-deps is enabled. A null `root` stands for all root modules, as
+/// the semantic analysis of one root module may run that of others (also
+/// called by the front-end).
+void record(Module *root, const char *kind, Dsymbol *decl);
+
+/// Starts collecting the declarations recorded from now on, including those
+/// of root modules, to be stored with a cached CTFE result (also called by
+/// the front-end).
+void startCapture();
+
+/// Ends the innermost capture and appends its declarations to `buf`, one
+/// "<kind>\t<declaration>\t<file>" line each (also called by the front-end).
+void endCapture(OutBuffer *buf);
+
+/// Records the declarations of a capture (see endCapture()) for all root
+/// modules (also called by the front-end).
+void replay(const char *data, size_t length);
+
+/// Writes the -body-deps file for the root modules.
+void write(Modules &modules);
+}
+
+#endif
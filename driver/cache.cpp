@@ -25,6 +25,9 @@
 // The hash depends on the IR code (obviously), but also on the compiler+LLVM
 // versions and several compile flags (e.g. -O*, -mcpu, and -mattr).
 //
+// With -cache-ctfe, the same directory also holds the results of pure CTFE
+// calls (ircache_<hash>.ctfe), keyed by ddmd/ctfecache.d.
+//
 //===----------------------------------------------------------------------===//
 
 #include "driver/cache.h"
@@ -36,6 +39,7 @@
 #include "driver/ldc-version.h"
 #include "gen/logger.h"
 #include "gen/optimizer.h"
+#include "rmem.h"
 
 #if LDC_LLVM_VER >= 400
 #include "llvm/Bitcode/BitcodeWriter.h"
@@ -46,8 +50,10 @@
 #endif
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
+#include <cstring>
 
 // Include close() declaration.
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
@@ -213,6 +219,20 @@ void storeCacheFileName(llvm::StringRef cacheObjectHash,
                                         "." + global.obj_ext);
 }
 
+void storeCtfeCacheFileName(const char *key, size_t keylen,
+                            llvm::SmallString<128> &filePath) {
+  raw_hash_ostream hash_os;
+  hash_os << global.ldc_version << global.version << global.llvm_version
+          << ldc::built_with_Dcompiler_version;
+  hash_os << llvm::StringRef(key, keylen);
+  llvm::SmallString<32> hash;
+  hash_os.resultAsString(hash);
+
+  filePath = opts::cacheDir;
+  llvm::sys::path::append(filePath,
+                          llvm::Twine("ircache_") + hash + ".ctfe");
+}
+
 // Output to `hash_os` all commandline flags, and try to skip the ones that have
 // no influence on the object code output. The cmdline flags need to be added
 // to the ir2obj cache hash to uniquely identify the object file output.
@@ -474,6 +494,64 @@ void recoverObjectFile(llvm::StringRef cacheObjectHash,
   }
 }
 
+bool ctfeCacheLookup(const char *key, size_t keylen, char **value,
+                     size_t *valuelen) {
+  if (opts::cacheDir.empty())
+    return false;
+
+  llvm::SmallString<128> filePath;
+  storeCtfeCacheFileName(key, keylen, filePath);
+  auto buffer = llvm::MemoryBuffer::getFile(filePath);
+  if (!buffer) {
+    IF_LOG Logger::println("CTFE result not cached: %s", filePath.c_str());
+    return false;
+  }
+
+  IF_LOG Logger::println("CTFE result found! %s", filePath.c_str());
+  const size_t size = (*buffer)->getBufferSize();
+  *value = static_cast<char *>(mem.xmalloc(size ? size : 1));
+  memcpy(*value, (*buffer)->getBufferStart(), size);
+  *valuelen = size;
+  return true;
+}
+
+void ctfeCacheStore(const char *key, size_t keylen, const char *value,
+                    size_t valuelen) {
+  if (opts::cacheDir.empty())
+    return;
+
+  // A missing CTFE result only costs time, so failures aren't errors.
+  if (!llvm::sys::fs::exists(opts::cacheDir) &&
+      llvm::sys::fs::create_directories(opts::cacheDir)) {
+    IF_LOG Logger::println("Unable to create cache directory: %s",
+                           opts::cacheDir.c_str());
+    return;
+  }
+
+  llvm::SmallString<128> cacheFile;
+  storeCtfeCacheFileName(key, keylen, cacheFile);
+
+  // Write atomically, see cacheObjectFile().
+  int fd;
+  llvm::SmallString<128> tempFile;
+  if (llvm::sys::fs::createUniqueFile(llvm::Twine(cacheFile) + ".tmp%%%%%%%",
+                                      fd, tempFile)) {
+    IF_LOG Logger::println("Could not create temporary file in the cache.");
+    return;
+  }
+  {
+    llvm::raw_fd_ostream os(fd, /*shouldClose=*/true);
+    os.write(value, valuelen);
+  }
+
+  IF_LOG Logger::println("Rename temp file to cache file: %s to %s",
+                         tempFile.c_str(), cacheFile.c_str());
+  if (llvm::sys::fs::rename(tempFile.c_str(), cacheFile.c_str())) {
+    IF_LOG Logger::println("Failed to rename temp file to cache file.");
+    llvm::sys::fs::remove(tempFile.c_str());
+  }
+}
+
 void pruneCache() {
   if (!opts::cacheDir.empty() && isPruningEnabled()) {
     ::pruneCache(opts::cacheDir.data(), opts::cacheDir.size(), pruneInterval,
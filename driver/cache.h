@@ -10,6 +10,7 @@
 #ifndef LDC_DRIVER_IR2OBJ_CACHE_H
 #define LDC_DRIVER_IR2OBJ_CACHE_H
 
+#include <cstddef>
 #include <string>
 
 namespace llvm {
@@ -27,6 +28,13 @@ void cacheObjectFile(llvm::StringRef objectFile,
 void recoverObjectFile(llvm::StringRef cacheObjectHash,
                        llvm::StringRef objectFile);
 
+/// Look up / store the result of a CTFE call (-cache-ctfe), see
+/// ddmd/ctfecache.d. The looked up value is allocated with mem.xmalloc().
+bool ctfeCacheLookup(const char *key, size_t keylen, char **value,
+                     size_t *valuelen);
+void ctfeCacheStore(const char *key, size_t keylen, const char *value,
+                    size_t valuelen);
+
 /// Prune the cache to avoid filling up disk space.
 ///
 /// Note: Does nothing for LLVM < 3.7.
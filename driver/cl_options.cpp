@@ -8,6 +8,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "driver/cl_options.h"
+#include "errors.h"
 #include "mars.h"
 #include "gen/cl_helpers.h"
 #include "gen/logger.h"
@@ -101,6 +102,13 @@ static cl::opt<bool, true> verbose_cg("v-cg", cl::desc("Verbose codegen"),
                                       cl::ZeroOrMore,
                                       cl::location(global.params.verbose_cg));
 
+cl::opt<std::string>
+    memReport("fmem-report", cl::ZeroOrMore, cl::ValueOptional,
+              cl::value_desc("filename"),
+              cl::desc("Report the memory used per compilation phase and per "
+                       "allocation category, to stderr or as JSON to "
+                       "<filename>"));
+
 static cl::opt<unsigned, true> errorLimit(
     "verrors", cl::ZeroOrMore, cl::location(global.errorLimit),
     cl::desc("Limit the number of error messages (0 means unlimited)"));
@@ -132,6 +140,20 @@ static cl::opt<ubyte, true> debugInfo(
         clEnumValN(3, "gline-tables-only", "Add line tables only")),
     cl::location(global.params.symdebug), cl::init(0));
 
+cl::opt<bool> splitDwarf(
+    "gsplit-dwarf", cl::ZeroOrMore,
+    cl::desc("Emit the DWARF debug info into separate .dwo files, leaving only "
+             "skeleton units in the object files (ELF targets)"));
+
+cl::opt<bool> compressDebugSections(
+    "gz", cl::ZeroOrMore,
+    cl::desc("Compress the DWARF debug sections with zlib (ELF targets)"));
+
+cl::opt<bool> limitedTypeDebugInfo(
+    "glimited-types", cl::ZeroOrMore,
+    cl::desc("Only describe the members of aggregates in the debug info of "
+             "the module defining them, other modules merely declare them"));
+
 static cl::opt<unsigned, true>
     dwarfVersion("dwarf-version", cl::desc("Dwarf version"), cl::ZeroOrMore,
                  cl::location(global.params.dwarfVersion), cl::Hidden);
@@ -168,6 +190,11 @@ cl::opt<bool> output_s("output-s", cl::desc("Write native assembly"),
 cl::opt<cl::boolOrDefault> output_o("output-o", cl::ZeroOrMore,
                                     cl::desc("Write native object"));
 
+cl::opt<bool> inMemoryObjects(
+    "in-memory-objects", cl::ZeroOrMore,
+    cl::desc("Keep object files in memory and hand them directly to the "
+             "internal archiver instead of writing them to disk (-lib only)"));
+
 static cl::opt<bool, true>
     cleanupObjectFiles("cleanup-obj", cl::ZeroOrMore, cl::ReallyHidden,
                        cl::desc("Remove generated object files on success"),
@@ -214,6 +241,13 @@ cl::opt<std::string> hdrFile("Hf", cl::ZeroOrMore, cl::Prefix,
                              cl::desc("Write 'header' file to <filename>"),
                              cl::value_desc("filename"));
 
+cl::opt<std::string> interfaceCacheDir(
+    "interface-cache", cl::ZeroOrMore,
+    cl::desc("Write an interface file of each compiled module to "
+             "<directory>, and import modules from there if the interface is "
+             "up to date (experimental)"),
+    cl::value_desc("directory"));
+
 cl::opt<bool>
     hdrKeepAllBodies("Hkeep-all-bodies", cl::ZeroOrMore,
                      cl::desc("Keep all function bodies in .di files"));
@@ -228,6 +262,11 @@ cl::opt<std::string>
                       "store cache files (experimental)"),
              cl::value_desc("cache dir"), cl::ZeroOrMore);
 
+static cl::opt<bool, true> cacheCtfe(
+    "cache-ctfe", cl::ZeroOrMore, cl::location(global.params.cacheCtfe),
+    cl::desc("Also store the results of pure CTFE calls in the -cache "
+             "directory and reuse them in later compilations (experimental)"));
+
 static StringsAdapter strImpPathStore("J", global.params.fileImppath);
 static cl::list<std::string, StringsAdapter> stringImportPaths(
     "J", cl::desc("Look for string imports also in <directory>"),
@@ -287,6 +326,12 @@ cl::list<std::string>
                cl::desc("Pass <ccflag> to GCC/Clang for linking"),
                cl::value_desc("ccflag"));
 
+cl::opt<std::string> bodyDeps(
+    "body-deps", cl::ZeroOrMore,
+    cl::desc("Write the imported declarations whose bodies are used for CTFE, "
+             "template instantiation or cross-module inlining to <filename>"),
+    cl::value_desc("filename"));
+
 cl::opt<std::string>
     moduleDeps("deps", cl::ValueOptional, cl::ZeroOrMore,
                cl::value_desc("filename"),
@@ -420,11 +465,47 @@ cl::opt<uint32_t, true> hashThreshold(
     "hash-threshold", cl::ZeroOrMore, cl::location(global.params.hashThreshold),
     cl::desc("Hash symbol names longer than this threshold (experimental)"));
 
+static cl::opt<uint32_t, true> parseThreads(
+    "parse-threads", cl::ZeroOrMore, cl::location(global.params.parseThreads),
+    cl::init(1),
+    cl::desc("Lex and parse the source files and the modules they import on "
+             "<N> threads (0: one per hardware thread, default: 1)"),
+    cl::value_desc("N"));
+
+static cl::opt<bool, true> ctfeBytecode(
+    "ctfe-bytecode", cl::ZeroOrMore, cl::location(global.params.ctfeBytecode),
+    cl::desc("Evaluate functions computing with integral values only by "
+             "compiling them to bytecode instead of interpreting the AST "
+             "during CTFE (experimental)"));
+
+static cl::opt<bool, true> lazyImports(
+    "lazy-imports", cl::ZeroOrMore, cl::location(global.params.lazyImports),
+    cl::desc("Don't evaluate the initializers of global variables and the "
+             "static asserts of imported modules unless they are needed "
+             "(experimental)"));
+
 cl::opt<bool> linkonceTemplates(
     "linkonce-templates", cl::ZeroOrMore,
     cl::desc(
         "Use linkonce_odr linkage for template symbols instead of weak_odr"));
 
+cl::opt<bool> typeInfoInDefiningModule(
+    "typeinfo-once", cl::ZeroOrMore,
+    cl::desc("Only emit the TypeInfo of non-templated structs in the module "
+             "defining them instead of in every module using it"));
+
+cl::opt<bool> ctorOnlyModuleInfoImports(
+    "minfo-ctor-imports", cl::ZeroOrMore,
+    cl::desc("Only reference the nearest (transitively) imported modules with "
+             "static constructors/destructors in ModuleInfo, shrinking the "
+             "graph druntime sorts at startup"));
+
+cl::opt<bool> noClassFactory(
+    "no-class-factory", cl::ZeroOrMore,
+    cl::desc("Omit the ModuleInfo localClasses[] arrays and ClassInfo default "
+             "constructor references (disables Object.factory() and "
+             "ClassInfo.create())"));
+
 cl::opt<bool> disableLinkerStripDead(
     "disable-linker-strip-dead", cl::ZeroOrMore,
     cl::desc("Do not try to remove unused symbols during linking"));
@@ -441,6 +522,41 @@ void setDefaultMathOptions(llvm::TargetMachine &target) {
   }
 }
 
+void setDebugInfoOptions() {
+  if (!global.params.symdebug)
+    return;
+
+  if ((splitDwarf || compressDebugSections) &&
+      !global.params.targetTriple->isOSBinFormatELF()) {
+    error(Loc(), "-gsplit-dwarf and -gz are only supported for ELF targets");
+    return;
+  }
+
+  if (splitDwarf) {
+    // The DWARF emitter decides whether to split the debug info based on a
+    // (hidden) LLVM option.
+#if LDC_LLVM_VER >= 307
+    llvm::StringMap<cl::Option *> &map = cl::getRegisteredOptions();
+#else
+    llvm::StringMap<cl::Option *> map;
+    cl::getRegisteredOptions(map);
+#endif
+    auto it = map.find("split-dwarf");
+    if (it == map.end()) {
+      error(Loc(), "-gsplit-dwarf is not supported by this LLVM version");
+      return;
+    }
+    it->second->addOccurrence(0, "split-dwarf", "Enable");
+  }
+
+#if LDC_LLVM_VER < 500
+  // With LLVM 5.0+, createTargetMachine() enables the compression.
+  if (compressDebugSections) {
+    error(Loc(), "-gz requires LDC built with LLVM 5.0+");
+  }
+#endif
+}
+
 cl::opt<bool, true>
     allinst("allinst", cl::ZeroOrMore, cl::location(global.params.allInst),
             cl::desc("Generate code for all template instantiations"));
@@ -469,6 +585,24 @@ cl::opt<unsigned char, true, CoverageParser> coverageAnalysis(
              "minimum required coverage)"),
     cl::ValueOptional, cl::init(127));
 
+cl::opt<CoverageIncrement> coverageIncrement(
+    "cov-increment", cl::ZeroOrMore,
+    cl::desc("Set the type of coverage line count increment instruction"),
+    cl::init(CoverageIncrement::_default),
+    clEnumValues(clEnumValN(CoverageIncrement::_default, "default",
+                            "Use the default (atomic)"),
+                 clEnumValN(CoverageIncrement::atomic, "atomic",
+                            "Atomic increment"),
+                 clEnumValN(CoverageIncrement::nonatomic, "non-atomic",
+                            "Non-atomic increment (not thread safe)"),
+                 clEnumValN(CoverageIncrement::boolean, "boolean",
+                            "Don't read, just set counter to 1")));
+
+cl::opt<bool> coverageBlockCounters(
+    "cov-block-counters", cl::ZeroOrMore,
+    cl::desc("Use one coverage counter per straight-line code region instead "
+             "of one per statement"));
+
 #if LDC_WITH_PGO
 cl::opt<std::string>
     genfileInstrProf("fprofile-instr-generate", cl::value_desc("filename"),
@@ -49,6 +49,7 @@ extern cl::opt<bool> compileOnly;
 extern cl::opt<bool> useDIP1000;
 extern cl::opt<bool> noAsm;
 extern cl::opt<bool> dontWriteObj;
+extern cl::opt<bool> inMemoryObjects;
 extern cl::opt<std::string> objectFile;
 extern cl::opt<std::string> objectDir;
 extern cl::opt<std::string> soname;
@@ -62,9 +63,12 @@ extern cl::opt<std::string> jsonFile;
 extern cl::opt<std::string> hdrDir;
 extern cl::opt<std::string> hdrFile;
 extern cl::opt<bool> hdrKeepAllBodies;
+extern cl::opt<std::string> interfaceCacheDir;
 extern cl::list<std::string> versions;
 extern cl::list<std::string> transitions;
 extern cl::opt<std::string> moduleDeps;
+extern cl::opt<std::string> bodyDeps;
+extern cl::opt<std::string> memReport;
 extern cl::opt<std::string> cacheDir;
 extern cl::list<std::string> linkerSwitches;
 extern cl::list<std::string> ccSwitches;
@@ -83,8 +87,17 @@ extern cl::opt<llvm::CodeModel::Model> mCodeModel;
 extern cl::opt<bool> disableFpElim;
 extern cl::opt<FloatABI::Type> mFloatABI;
 extern cl::opt<bool> linkonceTemplates;
+extern cl::opt<bool> typeInfoInDefiningModule;
+extern cl::opt<bool> ctorOnlyModuleInfoImports;
+extern cl::opt<bool> noClassFactory;
 extern cl::opt<bool> disableLinkerStripDead;
 
+// Debug info options
+extern cl::opt<bool> splitDwarf;
+extern cl::opt<bool> compressDebugSections;
+extern cl::opt<bool> limitedTypeDebugInfo;
+void setDebugInfoOptions();
+
 // Math options
 extern bool fFastMath;
 extern llvm::FastMathFlags defaultFMF;
@@ -99,6 +112,11 @@ extern cl::opt<std::string> usefileInstrProf;
 #endif
 extern cl::opt<bool> instrumentFunctions;
 
+// Coverage analysis
+enum class CoverageIncrement { _default, atomic, nonatomic, boolean };
+extern cl::opt<CoverageIncrement> coverageIncrement;
+extern cl::opt<bool> coverageBlockCounters;
+
 // Arguments to -d-debug
 extern std::vector<std::string> debugArgs;
 // Arguments to -run
@@ -15,14 +15,22 @@
 #include "scope.h"
 #include "driver/cl_options.h"
 #include "driver/linker.h"
+#include "driver/memstats.h"
 #include "driver/toobj.h"
 #include "gen/logger.h"
 #include "gen/modules.h"
 #include "gen/runtime.h"
+#if LDC_LLVM_VER >= 307
+#include "llvm/IR/LegacyPassManager.h"
+#else
+#include "llvm/PassManager.h"
+#endif
+#include "llvm/Linker/Linker.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/YAMLTraits.h"
+#include "llvm/Transforms/IPO.h"
 
 /// The module with the frontend-generated C main() definition.
 extern Module *g_entrypointModule;
@@ -165,11 +173,51 @@ void emitLLVMUsedArray(IRState &irs) {
   llvmUsed->setSection("llvm.metadata");
 }
 
+/// Emits the module-level data collected while generating the IR for one or
+/// more D modules.
+void finalizeLLModule(IRState &irs) {
+  irs.DBuilder.Finalize();
+
+  emitLLVMUsedArray(irs);
+  emitLinkerOptions(irs, irs.module, irs.context());
+}
+
+#if LDC_LLVM_VER >= 306
+/// Links the given LLVM module into the destination one.
+void linkInModule(llvm::Module &dest, std::unique_ptr<llvm::Module> src) {
+  const std::string srcName = src->getModuleIdentifier();
+#if LDC_LLVM_VER >= 308
+  const bool failed = llvm::Linker(dest).linkInModule(std::move(src));
+#else
+  const bool failed = llvm::Linker(&dest).linkInModule(src.get());
+#endif
+  if (failed) {
+    error(Loc(), "Error when linking the LLVM module of %s into %s",
+          srcName.c_str(), dest.getModuleIdentifier().c_str());
+    fatal();
+  }
+}
+
+/// Folds the identical unnamed_addr constants (string and array literals) the
+/// linked-together D modules have pooled individually, independent of the
+/// optimization level.
+void mergeConstants(llvm::Module &m) {
+#if LDC_LLVM_VER >= 307
+  llvm::legacy::PassManager pm;
+#else
+  llvm::PassManager pm;
+#endif
+  pm.add(llvm::createConstantMergePass());
+  pm.run(m);
+}
+#endif
+
 }
 
 namespace ldc {
 CodeGenerator::CodeGenerator(llvm::LLVMContext &context, bool singleObj)
-    : context_(context), moduleCount_(0), singleObj_(singleObj), ir_(nullptr) {
+    : context_(context), moduleCount_(0), singleObj_(singleObj), ir_(nullptr),
+      singleObjIR_(nullptr) {
   if (!ClassDeclaration::object) {
     error(Loc(), "declaration for class Object not found; druntime not "
                  "configured properly");
@@ -181,6 +229,12 @@ CodeGenerator::CodeGenerator(llvm::LLVMContext &context, bool singleObj)
   if (!global.params.output_ll) {
     context_.setDiscardValueNames(true);
   }
+
+  // Let the IR linker merge aggregate debug types with the same (mangled)
+  // unique identifier, e.g., for -singleobj builds and LTO.
+  if (global.params.symdebug) {
+    context_.enableDebugTypeODRUniquing();
+  }
 #endif
 }
 
@@ -190,6 +244,14 @@ CodeGenerator::~CodeGenerator() {
     // source file (e.g., `b.o` for `ldc2 a.o b.d c.d`).
     const char *filename = (*global.params.objfiles)[0];
 
+#if LDC_LLVM_VER >= 306
+    // All other D modules have been linked into the first one.
+    ir_ = singleObjIR_;
+    if (moduleCount_ > 1) {
+      mergeConstants(ir_->module);
+    }
+#endif
+
     // If there are bitcode files passed on the cmdline, add them after all
     // other source files have been added to the (singleobj) module.
     insertBitcodeFiles(ir_->module, ir_->context(),
@@ -202,9 +264,13 @@ CodeGenerator::~CodeGenerator() {
 void CodeGenerator::prepareLLModule(Module *m) {
   ++moduleCount_;
 
+#if LDC_LLVM_VER < 306
+  // Without the IR linker, all modules of single-object compilations are
+  // emitted into the same LLVM module (and debug info compile unit).
   if (singleObj_ && ir_) {
     return;
   }
+#endif
 
   assert(!ir_);
 
@@ -219,15 +285,29 @@ void CodeGenerator::prepareLLModule(Module *m) {
   ir_->module.setDataLayout(gDataLayout->getStringRepresentation());
 #endif
 
-  // TODO: Make ldc::DIBuilder per-Module to be able to emit several CUs for
-  // single-object compilations?
   ir_->DBuilder.EmitCompileUnit(m);
 
   IrDsymbol::resetAll();
 }
 
 void CodeGenerator::finishLLModule(Module *m) {
+  // Before writeAndFreeLLModule() records the optimize and emit phases.
+  memstats::recordPhase(
+      (llvm::Twine("codegen ") + m->toChars()).str().c_str());
+
   if (singleObj_) {
+#if LDC_LLVM_VER >= 306
+    // Every D module gets its own LLVM module and compile unit; link them into
+    // the first one, which is written out in the destructor.
+    finalizeLLModule(*ir_);
+    if (!singleObjIR_) {
+      singleObjIR_ = ir_;
+    } else {
+      linkInModule(singleObjIR_->module, ir_->releaseModule());
+      delete ir_;
+    }
+    ir_ = nullptr;
+#endif
     return;
   }
 
@@ -242,10 +322,12 @@ void CodeGenerator::finishLLModule(Module *m) {
 }
 
 void CodeGenerator::writeAndFreeLLModule(const char *filename) {
-  ir_->DBuilder.Finalize();
-
-  emitLLVMUsedArray(*ir_);
-  emitLinkerOptions(*ir_, ir_->module, ir_->context());
+#if LDC_LLVM_VER >= 306
+  // The modules of single-object compilations have been finalized
+  // individually before linking them together.
+  if (!singleObj_)
+#endif
+    finalizeLLModule(*ir_);
 
   // Emit ldc version as llvm.ident metadata.
   llvm::NamedMDNode *IdentMetadata =
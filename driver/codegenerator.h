@@ -39,6 +39,9 @@ private:
   int moduleCount_;
   bool const singleObj_;
   IRState *ir_;
+  // For single-object compilations, the state of the first module, which all
+  // other modules are linked into.
+  IRState *singleObjIR_;
 };
 }
 
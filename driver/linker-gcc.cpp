@@ -20,6 +20,12 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 
+#if LDC_WITH_LLD
+#include "lld/Driver/Driver.h"
+#include "llvm/Support/Path.h"
+#include <iterator>
+#endif
+
 //////////////////////////////////////////////////////////////////////////////
 
 static llvm::cl::opt<std::string>
@@ -41,16 +47,16 @@ public:
   void build(llvm::StringRef outputPath,
              llvm::cl::boolOrDefault fullyStaticFlag);
 
-private:
+protected:
   virtual void addSanitizers();
   virtual void addUserSwitches();
-  void addDefaultLibs();
+  virtual void addDefaultLibs();
   virtual void addArch();
 
 #if LDC_LLVM_VER >= 309
   void addLTOGoldPluginFlags();
   void addDarwinLTOFlags();
-  void addLTOLinkFlags();
+  virtual void addLTOLinkFlags();
 #endif
 
   virtual void addLdFlag(const llvm::Twine &flag) {
@@ -232,6 +238,11 @@ void ArgsBuilder::build(llvm::StringRef outputPath,
     if (!opts::disableLinkerStripDead && !global.params.genInstrProf) {
       addLdFlag("--gc-sections");
     }
+
+    // Keep the debug sections of the output compressed too (-gz).
+    if (opts::compressDebugSections && global.params.symdebug) {
+      addLdFlag("--compress-debug-sections=zlib");
+    }
   }
 
   addDefaultLibs();
@@ -397,9 +408,10 @@ void ArgsBuilder::addArch() {
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// (Yet unused) specialization for plain ld.
+// Specialization for plain ld.
 
 class LdArgsBuilder : public ArgsBuilder {
+protected:
   void addSanitizers() override {}
 
   void addUserSwitches() override {
@@ -423,12 +435,290 @@ class LdArgsBuilder : public ArgsBuilder {
   }
 };
 
+//////////////////////////////////////////////////////////////////////////////
+// Specialization for in-process linking with LLD on ELF targets. As there is
+// no GCC driver taking care of it, the C runtime startup files, libc, libgcc
+// and the dynamic linker need to be located by ourselves.
+
+#if LDC_WITH_LLD
+
+/// Returns the Debian-style multiarch directory name for the target, e.g.
+/// `x86_64-linux-gnu`.
+std::string getMultiarchTriple(const llvm::Triple &triple) {
+  const bool hardFloat =
+      triple.getEnvironment() == llvm::Triple::GNUEABIHF ||
+      triple.getEnvironment() == llvm::Triple::EABIHF;
+  switch (triple.getArch()) {
+  case llvm::Triple::x86:
+    return "i386-linux-gnu";
+  case llvm::Triple::x86_64:
+    return "x86_64-linux-gnu";
+  case llvm::Triple::aarch64:
+    return "aarch64-linux-gnu";
+  case llvm::Triple::arm:
+  case llvm::Triple::thumb:
+    return hardFloat ? "arm-linux-gnueabihf" : "arm-linux-gnueabi";
+  case llvm::Triple::ppc64le:
+    return "powerpc64le-linux-gnu";
+  case llvm::Triple::ppc64:
+    return "powerpc64-linux-gnu";
+  default:
+    return (triple.getArchName() + "-linux-gnu").str();
+  }
+}
+
+/// Returns the path to the glibc dynamic linker for the target, or an empty
+/// string for unsupported architectures.
+const char *getDynamicLinker(const llvm::Triple &triple) {
+  switch (triple.getArch()) {
+  case llvm::Triple::x86:
+    return "/lib/ld-linux.so.2";
+  case llvm::Triple::x86_64:
+    return "/lib64/ld-linux-x86-64.so.2";
+  case llvm::Triple::aarch64:
+    return "/lib/ld-linux-aarch64.so.1";
+  case llvm::Triple::arm:
+  case llvm::Triple::thumb:
+    return triple.getEnvironment() == llvm::Triple::GNUEABIHF
+               ? "/lib/ld-linux-armhf.so.3"
+               : "/lib/ld-linux.so.3";
+  case llvm::Triple::ppc64le:
+    return "/lib64/ld64.so.2";
+  case llvm::Triple::ppc64:
+    return "/lib64/ld64.so.1";
+  default:
+    return "";
+  }
+}
+
+/// Compares two dotted version strings numerically ("4.9.2" < "10.1").
+bool isOlderVersion(llvm::StringRef a, llvm::StringRef b) {
+  while (!a.empty() || !b.empty()) {
+    std::pair<llvm::StringRef, llvm::StringRef> sa = a.split('.'),
+                                                 sb = b.split('.');
+    unsigned va = 0, vb = 0;
+    sa.first.getAsInteger(10, va);
+    sb.first.getAsInteger(10, vb);
+    if (va != vb)
+      return va < vb;
+    a = sa.second;
+    b = sb.second;
+  }
+  return false;
+}
+
+/// Mirrors what the GCC driver would pass to the linker for the C runtime.
+struct ElfToolchainPaths {
+  /// Directory containing crtbegin.o & libgcc, e.g.
+  /// `/usr/lib/gcc/x86_64-linux-gnu/7`.
+  std::string gccLibDir;
+  /// Directory containing crt1.o, crti.o & libc.
+  std::string libcDir;
+  /// Additional system library search directories.
+  std::vector<std::string> libDirs;
+
+  bool discover(const llvm::Triple &triple);
+};
+
+bool ElfToolchainPaths::discover(const llvm::Triple &triple) {
+  namespace fs = llvm::sys::fs;
+  namespace path = llvm::sys::path;
+
+  const std::string multiarch = getMultiarchTriple(triple);
+  const bool is64bit = triple.isArch64Bit();
+
+  // The libc directories, in the order GCC searches them.
+  std::vector<std::string> candidates = {"/usr/lib/" + multiarch,
+                                         "/lib/" + multiarch};
+  if (is64bit) {
+    candidates.push_back("/usr/lib64");
+    candidates.push_back("/lib64");
+  } else {
+    candidates.push_back("/usr/lib32");
+    candidates.push_back("/lib32");
+  }
+  candidates.push_back("/usr/lib");
+  candidates.push_back("/lib");
+
+  for (const auto &dir : candidates) {
+    if (!fs::is_directory(dir))
+      continue;
+    if (libcDir.empty() && fs::exists(dir + "/crt1.o"))
+      libcDir = dir;
+    libDirs.push_back(dir);
+  }
+
+  // GCC's internal lib dir: <prefix>/gcc/<target>/<version>; pick the newest
+  // version for a target with matching architecture.
+  std::string bestVersion;
+  for (const char *prefix : {"/usr/lib/gcc", "/usr/lib64/gcc"}) {
+    std::error_code ec;
+    for (fs::directory_iterator it(prefix, ec), end; !ec && it != end;
+         it.increment(ec)) {
+      const llvm::Triple gccTriple(path::filename(it->path()));
+      if (gccTriple.getArch() != triple.getArch())
+        continue;
+
+      std::error_code ec2;
+      for (fs::directory_iterator vit(it->path(), ec2), vend;
+           !ec2 && vit != vend; vit.increment(ec2)) {
+        const llvm::StringRef version = path::filename(vit->path());
+        if (!fs::exists(vit->path() + "/crtbegin.o"))
+          continue;
+        if (bestVersion.empty() || isOlderVersion(bestVersion, version)) {
+          bestVersion = version;
+          gccLibDir = vit->path();
+        }
+      }
+    }
+  }
+
+  return !libcDir.empty() && !gccLibDir.empty();
+}
+
+class LldArgsBuilder : public LdArgsBuilder {
+public:
+  explicit LldArgsBuilder(const ElfToolchainPaths &paths,
+                          llvm::cl::boolOrDefault fullyStaticFlag)
+      : paths(paths), fullyStatic(fullyStaticFlag == llvm::cl::BOU_TRUE) {}
+
+  void build(llvm::StringRef outputPath,
+             llvm::cl::boolOrDefault fullyStaticFlag);
+
+private:
+  const ElfToolchainPaths &paths;
+  const bool fullyStatic;
+
+  bool isExecutable() const { return !global.params.dll; }
+
+  std::string crtBegin() const {
+    const char *name = fullyStatic ? "crtbeginT.o"
+                                   : isExecutable() ? "crtbegin.o"
+                                                    : "crtbeginS.o";
+    return paths.gccLibDir + "/" + name;
+  }
+
+  std::string crtEnd() const {
+    return paths.gccLibDir + "/" + (isExecutable() ? "crtend.o" : "crtendS.o");
+  }
+
+  void addDefaultLibs() override;
+
+#if LDC_LLVM_VER >= 309
+  void addLTOLinkFlags() override {
+    // LLD handles (Thin)LTO bitcode natively, no plugin required.
+    static char optChars[9] = "--lto-O0";
+    optChars[7] = '0' + std::min<char>(optLevel(), 3);
+    args.push_back(optChars);
+  }
+#endif
+};
+
+void LldArgsBuilder::build(llvm::StringRef outputPath,
+                           llvm::cl::boolOrDefault fullyStaticFlag) {
+#if LDC_LLVM_VER >= 400
+  // Write the output in parallel.
+  args.push_back("--threads");
+#endif
+  args.push_back("--eh-frame-hdr");
+
+  if (!fullyStatic && isExecutable()) {
+    args.push_back("--dynamic-linker");
+    args.push_back(getDynamicLinker(*global.params.targetTriple));
+  }
+
+  // C runtime startup files
+  if (isExecutable()) {
+    args.push_back(paths.libcDir + "/crt1.o");
+  }
+  args.push_back(paths.libcDir + "/crti.o");
+  args.push_back(crtBegin());
+
+  ArgsBuilder::build(outputPath, fullyStaticFlag);
+}
+
+void LldArgsBuilder::addDefaultLibs() {
+  ArgsBuilder::addDefaultLibs();
+
+  // System library search paths come after the user ones so that the latter
+  // take precedence, just like with the GCC driver.
+  args.push_back("-L" + paths.gccLibDir);
+  for (const auto &dir : paths.libDirs) {
+    args.push_back("-L" + dir);
+  }
+
+  // libc and libgcc, as linked by the GCC driver
+  if (fullyStatic) {
+    args.push_back("--start-group");
+    args.push_back("-lgcc");
+    args.push_back("-lgcc_eh");
+    args.push_back("-lc");
+    args.push_back("--end-group");
+  } else {
+    const char *libgcc[] = {"-lgcc", "--as-needed", "-lgcc_s",
+                            "--no-as-needed"};
+    args.insert(args.end(), std::begin(libgcc), std::end(libgcc));
+    args.push_back("-lc");
+    args.insert(args.end(), std::begin(libgcc), std::end(libgcc));
+  }
+
+  // C runtime shutdown files
+  args.push_back(crtEnd());
+  args.push_back(paths.libcDir + "/crtn.o");
+}
+
+#endif // LDC_WITH_LLD
+
 } // anonymous namespace
 
 //////////////////////////////////////////////////////////////////////////////
 
+#if LDC_WITH_LLD
+static int linkObjToBinaryLLD(llvm::StringRef outputPath,
+                              llvm::cl::boolOrDefault fullyStaticFlag) {
+  const llvm::Triple &triple = *global.params.targetTriple;
+  if (!triple.isOSLinux() || !triple.isOSBinFormatELF() ||
+      triple.getEnvironment() == llvm::Triple::Android ||
+      !*getDynamicLinker(triple)) {
+    error(Loc(), "-link-internally is not supported for target %s",
+          triple.str().c_str());
+    return 1;
+  }
+
+  ElfToolchainPaths paths;
+  if (!paths.discover(triple)) {
+    error(Loc(), "-link-internally: could not locate the C runtime startup "
+                 "files (crt1.o, crtbegin.o) for %s",
+          triple.str().c_str());
+    return 1;
+  }
+
+  LldArgsBuilder argsBuilder(paths, fullyStaticFlag);
+  argsBuilder.build(outputPath, fullyStaticFlag);
+
+  const auto fullArgs =
+      getFullArgs("ld.lld", argsBuilder.args, global.params.verbose);
+
+#if LDC_LLVM_VER >= 400
+  const bool success = lld::elf::link(fullArgs, /*CanExitEarly=*/false);
+#else
+  const bool success = lld::elf::link(fullArgs);
+#endif
+  if (!success)
+    error(Loc(), "linking with LLD failed");
+
+  return success ? 0 : 1;
+}
+#endif
+
 int linkObjToBinaryGcc(llvm::StringRef outputPath, bool useInternalLinker,
                        llvm::cl::boolOrDefault fullyStaticFlag) {
+#if LDC_WITH_LLD
+  if (useInternalLinker) {
+    return linkObjToBinaryLLD(outputPath, fullyStaticFlag);
+  }
+#endif
+
   // find gcc for linking
   const std::string tool = getGcc();
 
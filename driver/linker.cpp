@@ -27,8 +27,9 @@ static llvm::cl::opt<llvm::cl::boolOrDefault>
 
 #if LDC_WITH_LLD
 static llvm::cl::opt<bool>
-    useInternalLinker("link-internally", llvm::cl::ZeroOrMore, llvm::cl::Hidden,
-                      llvm::cl::desc("Use internal LLD for linking"));
+    useInternalLinker("link-internally", llvm::cl::ZeroOrMore,
+                      llvm::cl::desc("Use internal LLD for linking (MSVC and "
+                                     "Linux ELF targets)"));
 #else
 constexpr bool useInternalLinker = false;
 #endif
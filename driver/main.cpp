@@ -19,6 +19,7 @@
 #include "root.h"
 #include "scope.h"
 #include "ddmd/target.h"
+#include "driver/bodydeps.h"
 #include "driver/cache.h"
 #include "driver/cl_options.h"
 #include "driver/cl_options_sanitizers.h"
@@ -28,6 +29,7 @@
 #include "driver/exe_path.h"
 #include "driver/ldc-version.h"
 #include "driver/linker.h"
+#include "driver/memstats.h"
 #include "driver/targetmachine.h"
 #include "gen/cl_helpers.h"
 #include "gen/irstate.h"
@@ -65,6 +67,8 @@
 #include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <thread>
 #if _WIN32
 #include <windows.h>
 #endif
@@ -429,6 +433,8 @@ void parseCommandLine(int argc, char **argv, Strings &sourceFiles,
   initFromPathString(global.params.hdrname, hdrFile);
   global.params.doHdrGeneration |=
       global.params.hdrdir || global.params.hdrname;
+  initFromPathString(global.params.interfaceCacheDir, interfaceCacheDir);
+  initFromPathString(global.params.bodyDepsFile, bodyDeps);
 
   if (moduleDeps.getNumOccurrences() != 0) {
     global.params.moduleDeps = new OutBuffer;
@@ -453,6 +459,11 @@ void parseCommandLine(int argc, char **argv, Strings &sourceFiles,
   }
 #endif
 
+  if (global.params.parseThreads == 0) {
+    global.params.parseThreads =
+        std::max(1u, std::thread::hardware_concurrency());
+  }
+
 // PGO options
 #if LDC_WITH_PGO
   if (genfileInstrProf.getNumOccurrences() > 0) {
@@ -1060,6 +1071,7 @@ int cppmain(int argc, char **argv) {
   }
 
   opts::setDefaultMathOptions(*gTargetMachine);
+  opts::setDebugInfoOptions();
 
   // allocate the target abi
   gABI = TargetABI::getTarget();
@@ -1105,6 +1117,8 @@ void codegenModules(Modules &modules) {
            atCompute == DComputeCompileFor::hostAndDevice)
       {
         cg.emit(m);
+        if (global.params.verbose)
+          memstats::printVerbose(m->toChars());
       }
       if (atCompute != DComputeCompileFor::hostOnly)
         computeModules.push_back(m);
@@ -1121,6 +1135,10 @@ void codegenModules(Modules &modules) {
     }
   }
 
+  bodydeps::write(modules);
+
+  memstats::report();
+
   cache::pruneCache();
 
   freeRuntime();
@@ -0,0 +1,272 @@
+//===-- memstats.cpp ------------------------------------------------------===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "driver/memstats.h"
+
+#include "errors.h"
+#include "mars.h"
+#include "rmem.h"
+#include "driver/cl_options.h"
+#include "ir/irdsymbol.h"
+#include "ir/irtype.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#if _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#if LDC_LLVM_VER >= 306
+using LLErrorInfo = std::error_code;
+#define ERRORINFO_STRING(errinfo) errinfo.message().c_str()
+#else
+using LLErrorInfo = std::string;
+#define ERRORINFO_STRING(errinfo) errinfo.c_str()
+#endif
+
+// in ddmd/dinterpret.d
+struct CtfeMemStats {
+  d_size_t evaluations;
+  d_size_t arenaBytes;
+  d_size_t maxStackSlots;
+};
+extern CtfeMemStats ctfeMemStats;
+
+// in ddmd/dtemplate.d
+struct TemplateMemStats {
+  d_size_t instances;
+  d_size_t instanceBytes;
+  d_size_t arenaBytes;
+  d_size_t lookups;
+  d_size_t probes;
+  d_size_t maxProbes;
+};
+extern TemplateMemStats templateMemStats;
+
+namespace {
+
+struct PhaseStats {
+  std::string name;
+  uint64_t rss;
+  uint64_t peakRSS;
+  uint64_t arena;
+  uint64_t malloc;
+};
+
+std::vector<PhaseStats> phases;
+
+bool isEnabled() { return opts::memReport.getNumOccurrences() != 0; }
+
+double MiB(uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+void writeJSONString(llvm::raw_ostream &os, llvm::StringRef str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      os << llvm::format("\\u%04x", c);
+    else
+      os << c;
+  }
+  os << '"';
+}
+
+void printText(llvm::raw_ostream &os) {
+  os << "Memory report (MiB):\n";
+  os << llvm::format("  %-40s %10s %10s %10s %10s\n", "phase", "RSS",
+                     "peak RSS", "arena", "malloc");
+  for (const auto &p : phases) {
+    os << llvm::format("  %-40s %10.1f %10.1f %10.1f %10.1f\n", p.name.c_str(),
+                       MiB(p.rss), MiB(p.peakRSS), MiB(p.arena),
+                       MiB(p.malloc));
+  }
+
+  const auto category = [&os](const char *name, uint64_t count,
+                              const char *unit, uint64_t bytes) {
+    os << llvm::format("  %-20s %10llu %-12s %10.1f MiB\n", name,
+                       static_cast<unsigned long long>(count), unit,
+                       MiB(bytes));
+  };
+  os << "Allocations:\n";
+  category("front-end arena", Mem::arenaObjects(), "objects",
+           Mem::arenaSize());
+  category("Mem.xmalloc", Mem::mallocCount(), "calls", Mem::mallocBytes());
+  category("CTFE", ctfeMemStats.evaluations, "evaluations",
+           ctfeMemStats.arenaBytes);
+  os << llvm::format("  %-20s %10llu %-12s\n", "",
+                     static_cast<unsigned long long>(
+                         ctfeMemStats.maxStackSlots),
+                     "stack slots");
+  category("template instances", templateMemStats.instances, "instances",
+           templateMemStats.instanceBytes);
+  os << llvm::format("  %-20s %10s %-12s %10.1f MiB\n", "", "", "arena",
+                     MiB(templateMemStats.arenaBytes));
+  os << llvm::format(
+      "  %-20s %10llu %-12s %.2f avg, %llu max probes\n", "",
+      static_cast<unsigned long long>(templateMemStats.lookups), "lookups",
+      templateMemStats.lookups
+          ? double(templateMemStats.probes) / templateMemStats.lookups
+          : 0.0,
+      static_cast<unsigned long long>(templateMemStats.maxProbes));
+  category("IR symbols", IrDsymbol::list.size(), "objects",
+           IrDsymbol::list.size() * sizeof(IrDsymbol));
+  os << llvm::format("  %-20s %10llu %-12s\n", "IR types",
+                     static_cast<unsigned long long>(IrType::numCreated),
+                     "objects");
+  os << llvm::format("  %-20s %10s %-12s %10.1f MiB\n", "malloc in use", "",
+                     "", MiB(llvm::sys::Process::GetMallocUsage()));
+  os << llvm::format("  %-20s %10s %-12s %10.1f MiB\n", "peak RSS", "", "",
+                     MiB(memstats::getPeakRSS()));
+}
+
+void printJSON(llvm::raw_ostream &os) {
+  const auto field = [&os](const char *name, uint64_t value) {
+    os << "\"" << name << "\": " << value;
+  };
+
+  os << "{\n  \"phases\": [";
+  for (size_t i = 0; i < phases.size(); ++i) {
+    const auto &p = phases[i];
+    os << (i ? ",\n" : "\n") << "    {\"name\": ";
+    writeJSONString(os, p.name);
+    os << ", ";
+    field("rss", p.rss);
+    os << ", ";
+    field("peakRSS", p.peakRSS);
+    os << ", ";
+    field("arenaBytes", p.arena);
+    os << ", ";
+    field("mallocBytes", p.malloc);
+    os << "}";
+  }
+  os << "\n  ],\n  \"categories\": {\n";
+
+  os << "    \"frontendArena\": {";
+  field("objects", Mem::arenaObjects());
+  os << ", ";
+  field("bytes", Mem::arenaSize());
+  os << "},\n    \"xmalloc\": {";
+  field("calls", Mem::mallocCount());
+  os << ", ";
+  field("bytes", Mem::mallocBytes());
+  os << "},\n    \"ctfe\": {";
+  field("evaluations", ctfeMemStats.evaluations);
+  os << ", ";
+  field("arenaBytes", ctfeMemStats.arenaBytes);
+  os << ", ";
+  field("maxStackSlots", ctfeMemStats.maxStackSlots);
+  os << "},\n    \"templateInstances\": {";
+  field("instances", templateMemStats.instances);
+  os << ", ";
+  field("bytes", templateMemStats.instanceBytes);
+  os << ", ";
+  field("arenaBytes", templateMemStats.arenaBytes);
+  os << ", ";
+  field("lookups", templateMemStats.lookups);
+  os << ", ";
+  field("probes", templateMemStats.probes);
+  os << ", ";
+  field("maxProbes", templateMemStats.maxProbes);
+  os << "},\n    \"irSymbols\": {";
+  field("objects", IrDsymbol::list.size());
+  os << ", ";
+  field("bytes", IrDsymbol::list.size() * sizeof(IrDsymbol));
+  os << "},\n    \"irTypes\": {";
+  field("objects", IrType::numCreated);
+  os << "},\n    \"mallocInUse\": {";
+  field("bytes", llvm::sys::Process::GetMallocUsage());
+  os << "}\n  },\n  ";
+  field("peakRSS", memstats::getPeakRSS());
+  os << "\n}\n";
+}
+}
+
+uint64_t memstats::getPeakRSS() {
+#if _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.PeakWorkingSetSize;
+  return 0;
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if __APPLE__
+  return usage.ru_maxrss; // in bytes
+#else
+  return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // in KiB
+#endif
+#endif
+}
+
+uint64_t memstats::getCurrentRSS() {
+#if _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return counters.WorkingSetSize;
+  return 0;
+#elif __linux__
+  // The second field is the resident set size in pages.
+  unsigned long long size = 0, resident = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (!f)
+    return 0;
+  const bool ok = fscanf(f, "%llu %llu", &size, &resident) == 2;
+  fclose(f);
+  return ok ? resident * sysconf(_SC_PAGESIZE) : 0;
+#else
+  return 0;
+#endif
+}
+
+void memstats::printVerbose(const char *phase) {
+  const auto MiB = [](uint64_t bytes) {
+    return static_cast<unsigned long long>(bytes >> 20);
+  };
+  fprintf(global.stdmsg, "memory    %s: peak RSS %llu MiB, front-end arena %llu "
+                         "MiB\n",
+          phase, MiB(getPeakRSS()), MiB(Mem::arenaSize()));
+}
+
+void memstats::recordPhase(const char *phase) {
+  if (!isEnabled())
+    return;
+  phases.push_back({phase, getCurrentRSS(), getPeakRSS(), Mem::arenaSize(),
+                    llvm::sys::Process::GetMallocUsage()});
+}
+
+void memstats::report() {
+  if (!isEnabled())
+    return;
+
+  if (opts::memReport.empty()) {
+    printText(llvm::errs());
+    return;
+  }
+
+  LLErrorInfo errinfo;
+  llvm::raw_fd_ostream os(opts::memReport.c_str(), errinfo,
+                          llvm::sys::fs::F_Text);
+  if (os.has_error()) {
+    error(Loc(), "cannot write memory report '%s': %s",
+          opts::memReport.c_str(), ERRORINFO_STRING(errinfo));
+    return;
+  }
+  printJSON(os);
+}
@@ -0,0 +1,43 @@
+//===-- driver/memstats.h - Memory usage statistics -------------*- C++ -*-===//
+//
+//                         LDC – the LLVM D compiler
+//
+// This file is distributed under the BSD-style LDC license. See the LICENSE
+// file for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Queries the memory used by the compiler process and implements the
+// -fmem-report statistics.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LDC_DRIVER_MEMSTATS_H
+#define LDC_DRIVER_MEMSTATS_H
+
+#include <cstdint>
+
+namespace memstats {
+
+/// Returns the peak resident set size of the process so far in bytes, or 0 if
+/// it cannot be determined on this platform.
+uint64_t getPeakRSS();
+
+/// Returns the current resident set size of the process in bytes, or 0 if it
+/// cannot be determined on this platform.
+uint64_t getCurrentRSS();
+
+/// Prints the peak RSS and the front-end's arena size to the verbose output,
+/// prefixed by the given phase.
+void printVerbose(const char *phase);
+
+/// Takes a snapshot of the memory usage at the end of the given compilation
+/// phase if -fmem-report is enabled (also called by the front-end).
+void recordPhase(const char *phase);
+
+/// Prints the -fmem-report statistics to stderr, or writes them as JSON to
+/// the file given to -fmem-report=<filename>.
+void report();
+}
+
+#endif
@@ -629,6 +629,14 @@ createTargetMachine(std::string targetTriple, std::string arch, std::string cpu,
     targetOptions.DataSections = true;
   }
 
+#if LDC_LLVM_VER >= 500
+  // -gz; this is copied to the MCAsmInfo while creating the target machine.
+  if (opts::compressDebugSections && global.params.symdebug &&
+      triple.isOSBinFormatELF()) {
+    targetOptions.CompressDebugSections = llvm::DebugCompressionType::Z;
+  }
+#endif
+
   return target->createTargetMachine(triple.str(), cpu, features.getString(),
                                      targetOptions, relocModel, codeModel,
                                      codeGenOptLevel);
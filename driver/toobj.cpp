@@ -9,8 +9,10 @@
 
 #include "driver/toobj.h"
 
+#include "driver/archiver.h"
 #include "driver/cl_options.h"
 #include "driver/cache.h"
+#include "driver/memstats.h"
 #include "driver/targetmachine.h"
 #include "driver/tool.h"
 #include "gen/irstate.h"
@@ -35,6 +37,7 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormattedStream.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Program.h"
 #if LDC_LLVM_VER >= 307
 #include "llvm/Support/Path.h"
@@ -50,6 +53,7 @@
 #include "llvm/Target/TargetSubtargetInfo.h"
 #endif
 #include "llvm/IR/Module.h"
+#include "llvm/ADT/StringMap.h"
 #include <cstddef>
 #include <fstream>
 
@@ -61,6 +65,11 @@ using LLErrorInfo = std::string;
 #define ERRORINFO_STRING(errinfo) errinfo.c_str()
 #endif
 
+static llvm::cl::opt<std::string>
+    objcopy("objcopy", llvm::cl::ZeroOrMore, llvm::cl::Hidden,
+            llvm::cl::desc("objcopy to use for splitting DWARF debug info "
+                           "(-gsplit-dwarf)"));
+
 static llvm::cl::opt<bool>
     NoIntegratedAssembler("no-integrated-as", llvm::cl::ZeroOrMore,
                           llvm::cl::Hidden,
@@ -68,7 +77,11 @@ static llvm::cl::opt<bool>
 
 // based on llc code, University of Illinois Open Source License
 static void codegenModule(llvm::TargetMachine &Target, llvm::Module &m,
-                          llvm::raw_fd_ostream &out,
+#if LDC_LLVM_VER >= 307
+                          llvm::raw_pwrite_stream &out,
+#else
+                          llvm::raw_ostream &out,
+#endif
                           llvm::TargetMachine::CodeGenFileType fileType) {
   using namespace llvm;
 
@@ -190,6 +203,27 @@ static void assemble(const std::string &asmpath, const std::string &objpath) {
   }
 }
 
+static std::string getDwoFileName(const char *objpath) {
+  llvm::SmallString<128> dwopath(objpath);
+  llvm::sys::path::replace_extension(dwopath, "dwo");
+  return dwopath.str();
+}
+
+/// Moves the .dwo debug sections of the given object file into a separate
+/// .dwo file (-gsplit-dwarf).
+static void splitDwarfSections(const char *objpath,
+                               const std::string &dwopath) {
+  const std::string tool = getProgram("objcopy", &objcopy);
+
+  std::vector<std::string> extractArgs = {"--extract-dwo", objpath, dwopath};
+  std::vector<std::string> stripArgs = {"--strip-dwo", objpath};
+  if (executeToolAndWait(tool, extractArgs, global.params.verbose) ||
+      executeToolAndWait(tool, stripArgs, global.params.verbose)) {
+    error(Loc(), "Error while splitting debug info of '%s'.", objpath);
+    fatal();
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace {
@@ -372,7 +406,38 @@ public:
   }
 };
 
+/// Object files kept in memory, keyed by the file name they would have been
+/// written to.
+llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> inMemoryObjectFiles;
+
+bool shouldKeepObjectFileInMemory() {
+  // The object files are only consumed by the internal archiver; the cache
+  // works with on-disk files.
+  return opts::inMemoryObjects && global.params.lib &&
+         canArchiveFromMemory() && opts::cacheDir.empty() &&
+         !(opts::splitDwarf && global.params.symdebug);
+}
+
+void writeObjectFileToMemory(llvm::Module *m, const char *filename) {
+  IF_LOG Logger::println("Emitting object file to memory: %s", filename);
+  llvm::SmallString<0> buffer;
+  {
+    llvm::raw_svector_ostream out(buffer);
+    codegenModule(*gTargetMachine, *m, out,
+                  llvm::TargetMachine::CGFT_ObjectFile);
+  }
+  // Use the file name as buffer identifier, as it ends up as archive member
+  // name.
+  inMemoryObjectFiles[filename] = llvm::MemoryBuffer::getMemBufferCopy(
+      buffer, llvm::sys::path::filename(filename));
+}
+
 void writeObjectFile(llvm::Module *m, const char *filename) {
+  if (shouldKeepObjectFileInMemory()) {
+    writeObjectFileToMemory(m, filename);
+    return;
+  }
+
   IF_LOG Logger::println("Writing object file to: %s", filename);
   LLErrorInfo errinfo;
   {
@@ -421,10 +486,18 @@ bool shouldDoLTO(llvm::Module *m) {
 }
 } // end of anonymous namespace
 
+llvm::MemoryBuffer *getInMemoryObjectFile(llvm::StringRef filename) {
+  auto it = inMemoryObjectFiles.find(filename);
+  return it == inMemoryObjectFiles.end() ? nullptr : it->second.get();
+}
+
 void writeModule(llvm::Module *m, const char *filename) {
   const bool doLTO = shouldDoLTO(m);
   const bool outputObj = shouldOutputObjectFile();
   const bool assembleExternally = shouldAssembleExternally();
+  const bool useSplitDwarf =
+      opts::splitDwarf && global.params.symdebug && outputObj && !doLTO;
+  const std::string dwopath = useSplitDwarf ? getDwoFileName(filename) : "";
 
   // Use cached object code if possible.
   // TODO: combine LDC's cache and LTO (the advantage is skipping the IR
@@ -442,14 +515,22 @@ void writeModule(llvm::Module *m, const char *filename) {
 
     cache::calculateModuleHash(m, moduleHash);
     std::string cacheFile = cache::cacheLookup(moduleHash);
-    if (!cacheFile.empty()) {
+    // With -gsplit-dwarf, the .dwo file is cached alongside the skeleton
+    // object file.
+    const std::string dwoHash = (llvm::Twine(moduleHash) + "_dwo").str();
+    if (!cacheFile.empty() &&
+        (!useSplitDwarf || !cache::cacheLookup(dwoHash).empty())) {
       cache::recoverObjectFile(moduleHash, filename);
+      if (useSplitDwarf) {
+        cache::recoverObjectFile(dwoHash, dwopath);
+      }
       return;
     }
   }
 
   // run optimizer
   ldc_optimize_module(m);
+  memstats::recordPhase((llvm::Twine("optimize ") + filename).str().c_str());
 
   // make sure the output directory exists
   const auto directory = llvm::sys::path::parent_path(filename);
@@ -568,10 +649,19 @@ void writeModule(llvm::Module *m, const char *filename) {
 
   if (outputObj && !doLTO) {
     writeObjectFile(m, filename);
+    if (useSplitDwarf) {
+      splitDwarfSections(filename, dwopath);
+    }
     if (useIR2ObjCache) {
       cache::cacheObjectFile(filename, moduleHash);
+      if (useSplitDwarf) {
+        cache::cacheObjectFile(dwopath,
+                               (llvm::Twine(moduleHash) + "_dwo").str());
+      }
     }
   }
+
+  memstats::recordPhase((llvm::Twine("emit ") + filename).str().c_str());
 }
 
 #undef ERRORINFO_STRING
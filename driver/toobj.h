@@ -14,10 +14,17 @@
 #ifndef LDC_DRIVER_TOOBJ_H
 #define LDC_DRIVER_TOOBJ_H
 
+#include "llvm/ADT/StringRef.h"
+
 namespace llvm {
+class MemoryBuffer;
 class Module;
 }
 
 void writeModule(llvm::Module *m, const char *filename);
 
+/// Returns the object file emitted in memory for the given file name
+/// (-in-memory-objects), or null if it has been written to disk.
+llvm::MemoryBuffer *getInMemoryObjectFile(llvm::StringRef filename);
+
 #endif
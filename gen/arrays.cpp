@@ -622,14 +622,7 @@ void initializeArrayLiteral(IRState *p, ArrayLiteralExp *ale, LLValue *dstMem) {
     if (elemCount <= 4) {
       DtoStore(constarr, DtoBitCast(dstMem, getPtrToType(constarr->getType())));
     } else {
-      auto gvar = new llvm::GlobalVariable(gIR->module, constarr->getType(),
-                                           true, LLGlobalValue::InternalLinkage,
-                                           constarr, ".arrayliteral");
-#if LDC_LLVM_VER >= 309
-      gvar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
-#else
-      gvar->setUnnamedAddr(true);
-#endif
+      auto gvar = gIR->getPooledConstant(constarr, ".arrayliteral");
       DtoMemCpy(dstMem, gvar,
                 DtoConstSize_t(getTypeAllocSize(constarr->getType())));
     }
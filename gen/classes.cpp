@@ -13,6 +13,7 @@
 #include "init.h"
 #include "mtype.h"
 #include "target.h"
+#include "driver/cl_options.h"
 #include "gen/arrays.h"
 #include "gen/classes.h"
 #include "gen/dvalue.h"
@@ -645,7 +646,8 @@ LLConstant *DtoDefineClassInfo(ClassDeclaration *cd) {
   // defaultConstructor
   VarDeclaration *defConstructorVar = cinfo->fields.data[10];
   CtorDeclaration *defConstructor = cd->defaultCtor;
-  if (defConstructor && (defConstructor->storage_class & STCdisable)) {
+  if (defConstructor && ((defConstructor->storage_class & STCdisable) ||
+                         opts::noClassFactory)) {
     defConstructor = nullptr;
   }
   b.push_funcptr(defConstructor, defConstructorVar->type);
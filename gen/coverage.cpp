@@ -11,8 +11,118 @@
 
 #include "mars.h"
 #include "module.h"
+#include "driver/cl_options.h"
+#include "gen/funcgenstate.h"
 #include "gen/irstate.h"
 #include "gen/logger.h"
+#include "ir/irmodule.h"
+
+namespace {
+llvm::MDNode *getNontemporalNode() {
+#if LDC_LLVM_VER >= 306
+  return llvm::MDNode::get(gIR->context(),
+                           llvm::ConstantAsMetadata::get(DtoConstInt(1)));
+#else
+  llvm::Value *one = DtoConstInt(1);
+  return llvm::MDNode::get(gIR->context(), one);
+#endif
+}
+
+
+/// Emits the increment of the given counter according to -cov-increment and
+/// returns the last emitted instruction.
+llvm::Instruction *emitCounterIncrement(LLValue *ptr) {
+  switch (opts::coverageIncrement) {
+  case opts::CoverageIncrement::_default: // fallthrough
+  case opts::CoverageIncrement::atomic:
+    // Do an atomic increment, so this works when multiple threads are executed.
+    return gIR->ir->CreateAtomicRMW(llvm::AtomicRMWInst::Add, ptr,
+                                    DtoConstUint(1),
+#if LDC_LLVM_VER >= 309
+                                    llvm::AtomicOrdering::Monotonic
+#else
+                                    llvm::Monotonic
+#endif
+    );
+  case opts::CoverageIncrement::nonatomic: {
+    // Do a non-atomic increment, user is responsible for correct results with
+    // multithreaded execution.
+    llvm::LoadInst *load = gIR->ir->CreateAlignedLoad(ptr, 4);
+    llvm::StoreInst *store = gIR->ir->CreateAlignedStore(
+        gIR->ir->CreateAdd(load, DtoConstUint(1)), ptr, 4);
+    // Add !nontemporal metadata to inform the optimizer that caching is not
+    // needed.
+    llvm::MDNode *node = getNontemporalNode();
+    load->setMetadata("nontemporal", node);
+    store->setMetadata("nontemporal", node);
+    return store;
+  }
+  case opts::CoverageIncrement::boolean: {
+    // Do a boolean set, avoiding a (blocking) memory read and threading issues
+    // at the cost of not "counting". The .lst report then shows 1 for every
+    // executed line.
+    llvm::StoreInst *store =
+        gIR->ir->CreateAlignedStore(DtoConstUint(1), ptr, 4);
+    store->setMetadata("nontemporal", getNontemporalNode());
+    return store;
+  }
+  }
+  llvm_unreachable("Unknown coverage increment kind");
+}
+
+/// Returns whether control flow may leave the current basic block after the
+/// given instruction other than through the block's terminator, i.e. whether
+/// a call that may unwind has been emitted after it.
+bool mayUnwindAfter(llvm::Instruction *inst) {
+  llvm::BasicBlock *bb = inst->getParent();
+  for (auto it = ++llvm::BasicBlock::iterator(inst), end = bb->end();
+       it != end; ++it) {
+    llvm::CallSite cs(&*it);
+    if (cs && !cs.doesNotThrow()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// -cov-block-counters: Returns the index of the block counter covering the
+/// current insertion point, emitting a new counter increment if the previous
+/// one doesn't dominate the current statement in straight-line code.
+unsigned getCoverageBlockCounter(Module *m) {
+  IrModule *irm = getIrModule(m);
+  FuncGenState &funcGen = gIR->funcGen();
+
+  llvm::Instruction *last = funcGen.lastCoverageIncrement;
+  if (last && last->getParent() == gIR->scopebb() && !mayUnwindAfter(last)) {
+    IF_LOG Logger::println("Reusing block counter %u",
+                           funcGen.lastCoverageCounter);
+    return funcGen.lastCoverageCounter;
+  }
+
+  if (!irm->coverageBlockCounters) {
+    // The total number of counters is only known once the whole module has
+    // been emitted, so index into a placeholder for now; it is replaced by a
+    // properly sized array in addCoverageAnalysisBlockCounters().
+    auto i32Ty = LLType::getInt32Ty(gIR->context());
+    irm->coverageBlockCounters = new llvm::GlobalVariable(
+        gIR->module, i32Ty, false, LLGlobalValue::InternalLinkage,
+        llvm::ConstantInt::get(i32Ty, 0), "_d_cover_blocks");
+  }
+
+  const unsigned counter = irm->numCoverageBlockCounters++;
+  IF_LOG Logger::println("Coverage: increment _d_cover_blocks[%u]", counter);
+
+  LLValue *ptr = llvm::ConstantExpr::getGetElementPtr(
+#if LDC_LLVM_VER >= 307
+      LLType::getInt32Ty(gIR->context()),
+#endif
+      irm->coverageBlockCounters, DtoConstUint(counter));
+
+  funcGen.lastCoverageIncrement = emitCounterIncrement(ptr);
+  funcGen.lastCoverageCounter = counter;
+  return counter;
+}
+}
 
 void emitCoverageLinecountInc(Loc &loc) {
   Module *m = gIR->dmodule;
@@ -28,25 +138,25 @@ void emitCoverageLinecountInc(Loc &loc) {
   const unsigned line = loc.linnum - 1; // convert to 0-based line# index
   assert(line < m->numlines);
 
-  IF_LOG Logger::println("Coverage: increment _d_cover_data[%d]", line);
+  IF_LOG Logger::println("Coverage: count line %d", line);
   LOG_SCOPE;
 
-  // Get GEP into _d_cover_data array
-  LLConstant *idxs[] = {DtoConstUint(0), DtoConstUint(line)};
-  LLValue *ptr = llvm::ConstantExpr::getGetElementPtr(
+  if (opts::coverageBlockCounters) {
+    const unsigned counter = getCoverageBlockCounter(m);
+    getIrModule(m)->coverageLineCounters.push_back({line, counter});
+  } else {
+    IF_LOG Logger::println("Coverage: increment _d_cover_data[%d]", line);
+
+    // Get GEP into _d_cover_data array
+    LLConstant *idxs[] = {DtoConstUint(0), DtoConstUint(line)};
+    LLValue *ptr = llvm::ConstantExpr::getGetElementPtr(
 #if LDC_LLVM_VER >= 307
-      LLArrayType::get(LLType::getInt32Ty(gIR->context()), m->numlines),
+        LLArrayType::get(LLType::getInt32Ty(gIR->context()), m->numlines),
 #endif
-      m->d_cover_data, idxs, true);
+        m->d_cover_data, idxs, true);
 
-  // Do an atomic increment, so this works when multiple threads are executed.
-  gIR->ir->CreateAtomicRMW(llvm::AtomicRMWInst::Add, ptr, DtoConstUint(1),
-#if LDC_LLVM_VER >= 309
-                           llvm::AtomicOrdering::Monotonic
-#else
-                           llvm::Monotonic
-#endif
-  );
+    emitCounterIncrement(ptr);
+  }
 
   unsigned num_sizet_bits = gDataLayout->getTypeSizeInBits(DtoSize_t());
   unsigned idx = line / num_sizet_bits;
@@ -445,16 +445,23 @@ ldc::DIType ldc::DIBuilder::CreateCompositeType(Type *type) {
   IrTypeAggr *ir = sd->type->ctype->isAggr();
   assert(ir);
 
-  if (static_cast<llvm::MDNode *>(ir->diCompositeType) != nullptr) {
-    return ir->diCompositeType;
-  }
-
   // if we don't know the aggregate's size, we don't know enough about it
   // to provide debug info. probably a forward-declared struct?
   if (sd->sizeok == SIZEOKnone) {
     return DBuilder.createUnspecifiedType(sd->toChars());
   }
 
+  // With -glimited-types, only the module defining the aggregate (or
+  // instantiating it) describes its members; the debugger looks up the
+  // definition by name.
+  if (opts::limitedTypeDebugInfo && getDefinedModule(sd) != IR->dmodule) {
+    return CreateCompositeTypeDecl(t, sd);
+  }
+
+  if (static_cast<llvm::MDNode *>(ir->diCompositeType) != nullptr) {
+    return ir->diCompositeType;
+  }
+
   // elements
   llvm::SmallVector<LLMetadata *, 16> elems;
 
@@ -551,6 +558,33 @@ ldc::DIType ldc::DIBuilder::CreateCompositeType(Type *type) {
   return ret;
 }
 
+ldc::DIType ldc::DIBuilder::CreateCompositeTypeDecl(Type *t,
+                                                    AggregateDeclaration *sd) {
+  auto it = aggregateDecls.find(sd);
+  if (it != aggregateDecls.end()) {
+    return it->second;
+  }
+
+  LLType *T = DtoType(sd->type);
+  if (t->ty == Tclass)
+    T = llvm::cast<llvm::PointerType>(T)->getElementType();
+
+  unsigned tag = (t->ty == Tstruct) ? llvm::dwarf::DW_TAG_structure_type
+                                    : llvm::dwarf::DW_TAG_class_type;
+  ldc::DIType ret =
+      DBuilder.createForwardDecl(tag,                     // tag
+                                 sd->toChars(),           // name
+                                 GetCU(),                 // scope
+                                 CreateFile(sd),          // file
+                                 sd->loc.linnum,          // line number
+                                 0,                       // RunTimeLang
+                                 getTypeAllocSize(T) * 8, // size in bits
+                                 getABITypeAlign(T) * 8,  // alignment in bits
+                                 uniqueIdent(t));         // UniqueIdentifier
+  aggregateDecls[sd] = ret;
+  return ret;
+}
+
 ldc::DIType ldc::DIBuilder::CreateArrayType(Type *type) {
   llvm::Type *T = DtoType(type);
   Type *t = type->toBasetype();
@@ -788,6 +822,16 @@ void ldc::DIBuilder::EmitCompileUnit(Module *m) {
   llvm::SmallString<128> srcpath(m->srcfile->name->toChars());
   llvm::sys::fs::make_absolute(srcpath);
 
+  // -gsplit-dwarf: the (absolute) path of the .dwo file referenced by the
+  // skeleton unit, see writeModule().
+  llvm::SmallString<128> splitName;
+  if (opts::splitDwarf) {
+    splitName = global.params.oneobj ? (*global.params.objfiles)[0]
+                                     : m->objfile->name->toChars();
+    llvm::sys::fs::make_absolute(splitName);
+    llvm::sys::path::replace_extension(splitName, "dwo");
+  }
+
 #if LDC_LLVM_VER >= 308
   if (global.params.targetTriple->isWindowsMSVCEnvironment())
     IR->module.addModuleFlag(llvm::Module::Warning, "CodeView", 1);
@@ -812,7 +856,7 @@ void ldc::DIBuilder::EmitCompileUnit(Module *m) {
       isOptimizationEnabled(), // isOptimized
       llvm::StringRef(),       // Flags TODO
       1,                       // Runtime Version TODO
-      llvm::StringRef(),       // SplitName
+      splitName,               // SplitName
       getDebugEmissionKind()   // DebugEmissionKind
 #if LDC_LLVM_VER > 306
       , 0                      // DWOId
@@ -890,7 +934,9 @@ ldc::DISubprogram ldc::DIBuilder::EmitThunk(llvm::Function *Thunk,
   ldc::DIFile file = CreateFile(fd);
 
   // Create subroutine type (thunk has same type as wrapped function)
-  ldc::DISubroutineType DIFnType = CreateFunctionType(fd->type);
+  ldc::DISubroutineType DIFnType = mustEmitFullDebugInfo() ?
+      CreateFunctionType(fd->type) :
+      CreateEmptyFunctionType();
 
   std::string name = fd->toPrettyChars();
   name.append(".__thunk");
@@ -939,17 +985,22 @@ ldc::DISubprogram ldc::DIBuilder::EmitModuleCTor(llvm::Function *Fn,
   ldc::DIFile file = CreateFile();
 
   // Create "dummy" subroutine type for the return type
-  LLMetadata *params = {CreateTypeDescription(Type::tvoid)};
+  ldc::DISubroutineType DIFnType;
+  if (mustEmitFullDebugInfo()) {
+    LLMetadata *params = {CreateTypeDescription(Type::tvoid)};
 #if LDC_LLVM_VER >= 306
-  auto paramsArray = DBuilder.getOrCreateTypeArray(params);
+    auto paramsArray = DBuilder.getOrCreateTypeArray(params);
 #else
-  auto paramsArray = DBuilder.getOrCreateArray(params);
+    auto paramsArray = DBuilder.getOrCreateArray(params);
 #endif
 #if LDC_LLVM_VER >= 308
-  auto DIFnType = DBuilder.createSubroutineType(paramsArray);
+    DIFnType = DBuilder.createSubroutineType(paramsArray);
 #else
-  auto DIFnType = DBuilder.createSubroutineType(file, paramsArray);
+    DIFnType = DBuilder.createSubroutineType(file, paramsArray);
 #endif
+  } else {
+    DIFnType = CreateEmptyFunctionType();
+  }
 
   // FIXME: duplicates?
   auto SP =
@@ -1064,12 +1115,15 @@ void ldc::DIBuilder::EmitStopPoint(Loc &loc) {
 Loc ldc::DIBuilder::GetCurrentLoc() const { return currentLoc; }
 
 void ldc::DIBuilder::EmitValue(llvm::Value *val, VarDeclaration *vd) {
+  if (!mustEmitFullDebugInfo())
+    return;
+
   auto sub = IR->func()->variableMap.find(vd);
   if (sub == IR->func()->variableMap.end())
     return;
 
   ldc::DILocalVariable debugVariable = sub->second;
-  if (!mustEmitFullDebugInfo() || !debugVariable)
+  if (!debugVariable)
     return;
 
   llvm::Instruction *instr =
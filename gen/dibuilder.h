@@ -10,6 +10,7 @@
 #ifndef LDC_GEN_DIBUILDER_H
 #define LDC_GEN_DIBUILDER_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Type.h"
 #include "llvm/IR/DataLayout.h"
@@ -21,6 +22,7 @@
 
 struct IRState;
 
+class AggregateDeclaration;
 class ClassDeclaration;
 class Dsymbol;
 class FuncDeclaration;
@@ -91,6 +93,9 @@ class DIBuilder {
 
   Loc currentLoc;
 
+  /// Declarations of aggregates defined in other modules (-glimited-types).
+  llvm::DenseMap<AggregateDeclaration *, DIType> aggregateDecls;
+
 public:
   explicit DIBuilder(IRState *const IR);
 
@@ -192,6 +197,7 @@ private:
   DIType CreateMemberType(unsigned linnum, Type *type, DIFile file,
                           const char *c_name, unsigned offset, PROTKIND);
   DIType CreateCompositeType(Type *type);
+  DIType CreateCompositeTypeDecl(Type *type, AggregateDeclaration *sd);
   DIType CreateArrayType(Type *type);
   DIType CreateSArrayType(Type *type);
   DIType CreateAArrayType(Type *type);
@@ -200,13 +206,15 @@ private:
   DIType CreateDelegateType(Type *type);
   DIType CreateTypeDescription(Type *type);
 
+public:
+  /// Whether variables and types are described (-g, -gc), as opposed to
+  /// line tables only (-gline-tables-only).
   bool mustEmitFullDebugInfo();
   bool mustEmitLocationsDebugInfo();
 
-public:
   template <typename T>
   void OpOffset(T &addr, llvm::StructType *type, int index) {
-    if (!global.params.symdebug) {
+    if (!mustEmitFullDebugInfo()) {
       return;
     }
 
@@ -223,7 +231,7 @@ public:
   }
 
   template <typename T> void OpOffset(T &addr, llvm::Value *val, int index) {
-    if (!global.params.symdebug) {
+    if (!mustEmitFullDebugInfo()) {
       return;
     }
 
@@ -233,7 +241,7 @@ public:
   }
 
   template <typename T> void OpDeref(T &addr) {
-    if (!global.params.symdebug) {
+    if (!mustEmitFullDebugInfo()) {
       return;
     }
 
@@ -192,6 +192,11 @@ public:
   /// alloca for the nested context of this function
   llvm::Value *nestedVar = nullptr;
 
+  /// The frames of the enclosing functions, indexed by nesting depth. The last
+  /// one is the incoming context of a nested function, loaded at function
+  /// entry; the others are loaded from its frame list on first use.
+  llvm::SmallVector<llvm::Value *, 4> outerFrames;
+
   /// The basic block with the return instruction.
   llvm::BasicBlock *retBlock = nullptr;
 
@@ -199,6 +204,11 @@ public:
   /// value.
   llvm::AllocaInst *retValSlot = nullptr;
 
+  /// -cov-block-counters: The last emitted coverage counter increment and the
+  /// index of its counter, reused for statements in the same basic block.
+  llvm::Instruction *lastCoverageIncrement = nullptr;
+  unsigned lastCoverageCounter = 0;
+
   /// Emits a call or invoke to the given callee, depending on whether there
   /// are catches/cleanups active or not.
   template <typename T>
@@ -15,6 +15,8 @@
 #include "module.h"
 #include "statement.h"
 #include "template.h"
+#include "driver/bodydeps.h"
+#include "gen/irstate.h"
 #include "gen/logger.h"
 #include "gen/optimizer.h"
 #include "gen/recursivevisitor.h"
@@ -212,5 +214,6 @@ bool defineAsExternallyAvailable(FuncDeclaration &fdecl) {
   }
 
   IF_LOG Logger::println("defineAsExternallyAvailable? Yes.");
+  bodydeps::record(gIR->dmodule, "inline", &fdecl);
   return true;
 }
@@ -771,7 +771,7 @@ void defineParameters(IrFuncTy &irFty, VarDeclarations &parameters) {
       ++llArgIdx;
     }
 
-    if (global.params.symdebug)
+    if (gIR->DBuilder.mustEmitFullDebugInfo())
       gIR->DBuilder.EmitLocalVariable(irparam->value, vd, paramType);
   }
 }
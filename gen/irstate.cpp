@@ -35,7 +35,8 @@ IRScope &IRScope::operator=(const IRScope &rhs) {
 
 ////////////////////////////////////////////////////////////////////////////////
 IRState::IRState(const char *name, llvm::LLVMContext &context)
-    : module(name, context), DBuilder(this), dcomputetarget(nullptr) {
+    : ownedModule(new llvm::Module(name, context)), module(*ownedModule),
+      DBuilder(this), dcomputetarget(nullptr) {
   moduleRefType = nullptr;
 
   dmodule = nullptr;
@@ -145,6 +146,22 @@ bool IRState::emitArrayBoundsChecks() {
   return t->ty == Tfunction && ((TypeFunction *)t)->trust == TRUSTsafe;
 }
 
+llvm::GlobalVariable *IRState::getPooledConstant(llvm::Constant *init,
+                                                 const char *name) {
+  llvm::GlobalVariable *&gvar = constantPool[init];
+  if (!gvar) {
+    gvar = new llvm::GlobalVariable(module, init->getType(), true,
+                                    llvm::GlobalValue::PrivateLinkage, init,
+                                    name);
+#if LDC_LLVM_VER >= 309
+    gvar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+#else
+    gvar->setUnnamedAddr(true);
+#endif
+  }
+  return gvar;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 IRBuilder<> *IRBuilderHelper::operator->() {
@@ -25,9 +25,11 @@
 #include "gen/dibuilder.h"
 #include "ir/iraggr.h"
 #include "ir/irvar.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ProfileData/InstrProfReader.h"
 #include "llvm/IR/CallSite.h"
+#include "llvm/IR/ValueMap.h"
 
 namespace llvm {
 class LLVMContext;
@@ -113,9 +115,19 @@ struct IRState {
   IRState(IRState const &) = delete;
   IRState &operator=(IRState const &) = delete;
 
-  llvm::Module module;
+private:
+  std::unique_ptr<llvm::Module> ownedModule;
+
+public:
+  llvm::Module &module;
   llvm::LLVMContext &context() const { return module.getContext(); }
 
+  // Transfers ownership of the LLVM module, e.g., to link it into another one.
+  // No further code may be generated using this IRState afterwards.
+  std::unique_ptr<llvm::Module> releaseModule() {
+    return std::move(ownedModule);
+  }
+
   Module *dmodule;
 
   LLStructType *moduleRefType;
@@ -191,13 +203,24 @@ struct IRState {
   /// Whether to emit array bounds checking in the current function.
   bool emitArrayBoundsChecks();
 
-  // Global variables bound to string literals.  Once created such a
-  // variable is reused whenever the same string literal is
-  // referenced in the module.  Caching them per module prevents the
-  // duplication of identical literals.
-  llvm::StringMap<llvm::GlobalVariable *> stringLiteral1ByteCache;
-  llvm::StringMap<llvm::GlobalVariable *> stringLiteral2ByteCache;
-  llvm::StringMap<llvm::GlobalVariable *> stringLiteral4ByteCache;
+  /// Returns a private, unnamed_addr constant global with the given
+  /// initializer, creating it on first use.
+  ///
+  /// Used for the storage of string literals and immutable array literals.
+  /// As LLVM constants are uniqued per context, keying the pool by the
+  /// initializer folds identical literals of all element types without
+  /// keeping a copy of their contents, and the resulting globals are
+  /// candidates for the linker's mergeable constant sections.
+  llvm::GlobalVariable *getPooledConstant(llvm::Constant *init,
+                                          const char *name);
+
+private:
+  // A ValueMap, as the initializers may refer to globals which are replaced
+  // later (e.g. if their type doesn't match the initializer's), destroying
+  // and recreating the constants using them.
+  llvm::ValueMap<llvm::Constant *, llvm::GlobalVariable *> constantPool;
+
+public:
 
 /// Vector of options passed to the linker as metadata in object file.
 #if LDC_LLVM_VER >= 500
@@ -9,6 +9,7 @@
 
 #include "gen/moduleinfo.h"
 
+#include "driver/cl_options.h"
 #include "gen/abi.h"
 #include "gen/classes.h"
 #include "gen/irstate.h"
@@ -20,6 +21,7 @@
 #include "ir/irmodule.h"
 #include "ir/irtype.h"
 #include "module.h"
+#include "llvm/ADT/SmallPtrSet.h"
 
 // These must match the values in druntime/src/object_.d
 #define MIstandalone 0x4
@@ -136,19 +138,75 @@ llvm::Function *buildModuleSharedDtor(Module *m) {
   return buildForwarderFunction(name, getIrModule(m)->sharedDtors);
 }
 
+/// Returns whether the ModuleInfo needs to depend on druntime's rt.cover, i.e.
+/// whether the coverage line counts are only reconstructed by a shared module
+/// destructor (-cov-block-counters), which must run before the report is
+/// written.
+bool needsCoverageReportDependency(Module *m) {
+  return !getIrModule(m)->coverageLineCounters.empty();
+}
+
+/// Returns an external reference to the ModuleInfo of druntime's rt.cover.
+llvm::GlobalVariable *getCoverageReportModuleInfo() {
+  const char *name = "_D2rt5cover12__ModuleInfoZ";
+  if (auto gv = gIR->module.getGlobalVariable(name)) {
+    return gv;
+  }
+  return new llvm::GlobalVariable(
+      gIR->module, llvm::StructType::create(gIR->context()), false,
+      llvm::GlobalValue::ExternalLinkage, nullptr, name);
+}
+
+/// Collects the modules with static constructors/destructors imported by the
+/// given module, either directly or via root modules without any
+/// (-minfo-ctor-imports). These are the only ones relevant for druntime's
+/// constructor order, and paths between them are preserved.
+/// The imports of other modules aren't known completely, as function-local
+/// imports and those of template instances are only added by semantic3, so
+/// these modules are always kept.
+void collectCtorImports(Module *mod, llvm::SmallPtrSetImpl<Module *> &visited,
+                        std::vector<Module *> &result) {
+  for (auto imp : mod->aimports) {
+    // needModuleInfo() is propagated to importing modules, so there are no
+    // constructors to be found behind modules not needing a ModuleInfo.
+    if (!imp->needModuleInfo() || !visited.insert(imp).second) {
+      continue;
+    }
+
+    if (imp->hasStaticCtorOrDtor || !imp->isRoot()) {
+      result.push_back(imp);
+    } else {
+      collectCtorImports(imp, visited, result);
+    }
+  }
+}
+
 /// Builds the (constant) data content for the importedModules[] array.
 llvm::Constant *buildImportedModules(Module *m, size_t &count) {
   const auto moduleInfoPtrTy = DtoPtrToType(Module::moduleinfo->type);
 
-  std::vector<LLConstant *> importInits;
-  for (auto mod : m->aimports) {
-    if (!mod->needModuleInfo() || mod == m) {
-      continue;
+  std::vector<Module *> imports;
+  if (opts::ctorOnlyModuleInfoImports) {
+    llvm::SmallPtrSet<Module *, 16> visited;
+    visited.insert(m);
+    collectCtorImports(m, visited, imports);
+  } else {
+    for (auto mod : m->aimports) {
+      if (mod->needModuleInfo() && mod != m) {
+        imports.push_back(mod);
+      }
     }
+  }
 
+  std::vector<LLConstant *> importInits;
+  for (auto mod : imports) {
     importInits.push_back(
         DtoBitCast(getIrModule(mod)->moduleInfoSymbol(), moduleInfoPtrTy));
   }
+  if (needsCoverageReportDependency(m)) {
+    importInits.push_back(
+        DtoBitCast(getCoverageReportModuleInfo(), moduleInfoPtrTy));
+  }
   count = importInits.size();
 
   if (importInits.empty())
@@ -160,6 +218,12 @@ llvm::Constant *buildImportedModules(Module *m, size_t &count) {
 
 /// Builds the (constant) data content for the localClasses[] array.
 llvm::Constant *buildLocalClasses(Module *m, size_t &count) {
+  // Only used by Object.factory().
+  if (opts::noClassFactory) {
+    count = 0;
+    return nullptr;
+  }
+
   const auto classinfoTy = Type::typeinfoclass->type->ctype->getLLType();
 
   ClassDeclarations aclasses;
@@ -261,7 +325,7 @@ llvm::GlobalVariable *genModuleInfo(Module *m) {
     flags |= MIlocalClasses;
   }
 
-  if (!m->needmoduleinfo) {
+  if (!m->needmoduleinfo && !needsCoverageReportDependency(m)) {
     flags |= MIstandalone;
   }
 
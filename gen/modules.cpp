@@ -22,6 +22,7 @@
 #include "statement.h"
 #include "target.h"
 #include "template.h"
+#include "driver/cl_options.h"
 #include "gen/abi.h"
 #include "gen/arrays.h"
 #include "gen/functions.h"
@@ -614,6 +615,123 @@ void addCoverageAnalysis(Module *m) {
   IF_LOG Logger::undent();
 }
 
+// With -cov-block-counters, size the _d_cover_blocks array and add a module
+// destructor that accumulates the block counters into _d_cover_data, which
+// druntime's rt.cover then writes out.
+void addCoverageAnalysisBlockCounters(Module *m) {
+  IrModule *irm = getIrModule(m);
+  const unsigned numCounters = irm->numCoverageBlockCounters;
+  if (!numCounters) {
+    return;
+  }
+
+  const size_t numPairs = irm->coverageLineCounters.size();
+  IF_LOG {
+    Logger::println("Adding coverage block counters: %u counters for %llu "
+                    "line entries",
+                    numCounters, static_cast<unsigned long long>(numPairs));
+    Logger::indent();
+  }
+
+  LLType *i32Ty = LLType::getInt32Ty(gIR->context());
+
+  // Replace the placeholder by the properly sized uint[#counters] array.
+  llvm::GlobalVariable *placeholder = irm->coverageBlockCounters;
+  LLArrayType *blocksTy = LLArrayType::get(i32Ty, numCounters);
+  auto blocks = new llvm::GlobalVariable(
+      gIR->module, blocksTy, false, LLGlobalValue::InternalLinkage,
+      llvm::ConstantAggregateZero::get(blocksTy), "");
+  blocks->takeName(placeholder);
+  placeholder->replaceAllUsesWith(
+      llvm::ConstantExpr::getBitCast(blocks, placeholder->getType()));
+  placeholder->eraseFromParent();
+  irm->coverageBlockCounters = blocks;
+
+  // Constant table of {line#, counter index} pairs.
+  LLStructType *pairTy = LLStructType::get(gIR->context(), {i32Ty, i32Ty});
+  std::vector<LLConstant *> pairInits;
+  pairInits.reserve(numPairs);
+  for (const auto &p : irm->coverageLineCounters) {
+    LLConstant *fields[] = {DtoConstUint(p.first), DtoConstUint(p.second)};
+    pairInits.push_back(LLConstantStruct::get(pairTy, fields));
+  }
+  LLArrayType *tableTy = LLArrayType::get(pairTy, numPairs);
+  auto table = new llvm::GlobalVariable(
+      gIR->module, tableTy, true, LLGlobalValue::InternalLinkage,
+      llvm::ConstantArray::get(tableTy, pairInits), "_d_cover_lines");
+
+  OutBuffer mangleBuf;
+  mangleBuf.writestring("_D");
+  mangleToBuffer(m, &mangleBuf);
+  mangleBuf.writestring("12_coverageanalysisDtor1FZv");
+  const char *dtorname = mangleBuf.peekString();
+
+  IF_LOG Logger::println("Build Coverage Analysis destructor: %s", dtorname);
+
+  LLFunctionType *dtorTy = LLFunctionType::get(
+      LLType::getVoidTy(gIR->context()), std::vector<LLType *>(), false);
+  LLFunction *dtor = LLFunction::Create(
+      dtorTy, LLGlobalValue::InternalLinkage, dtorname, &gIR->module);
+  dtor->setCallingConv(gABI->callingConv(dtor->getFunctionType(), LINKd));
+  // Set function attributes. See functions.cpp:DtoDefineFunction()
+  if (global.params.targetTriple->getArch() == llvm::Triple::x86_64) {
+    dtor->addFnAttr(LLAttribute::UWTable);
+  }
+
+  // for (i = 0; i < numPairs; ++i)
+  //   _d_cover_data[table[i].line] += _d_cover_blocks[table[i].counter];
+  llvm::BasicBlock *entrybb =
+      llvm::BasicBlock::Create(gIR->context(), "", dtor);
+  llvm::BasicBlock *loopbb =
+      llvm::BasicBlock::Create(gIR->context(), "loop", dtor);
+  llvm::BasicBlock *endbb =
+      llvm::BasicBlock::Create(gIR->context(), "end", dtor);
+
+  IRBuilder<> builder(entrybb);
+  builder.CreateBr(loopbb);
+
+  builder.SetInsertPoint(loopbb);
+  llvm::PHINode *i = builder.CreatePHI(i32Ty, 2, "i");
+  i->addIncoming(DtoConstUint(0), entrybb);
+
+  LLValue *lineIdxs[] = {DtoConstUint(0), i, DtoConstUint(0)};
+  LLValue *line = builder.CreateLoad(builder.CreateInBoundsGEP(table, lineIdxs));
+  LLValue *counterIdxs[] = {DtoConstUint(0), i, DtoConstUint(1)};
+  LLValue *counter =
+      builder.CreateLoad(builder.CreateInBoundsGEP(table, counterIdxs));
+
+  LLValue *blockIdxs[] = {DtoConstUint(0), counter};
+  LLValue *count =
+      builder.CreateLoad(builder.CreateInBoundsGEP(blocks, blockIdxs));
+  LLValue *dataIdxs[] = {DtoConstUint(0), line};
+  LLValue *dataPtr = builder.CreateInBoundsGEP(m->d_cover_data, dataIdxs);
+  builder.CreateStore(builder.CreateAdd(builder.CreateLoad(dataPtr), count),
+                      dataPtr);
+
+  LLValue *next = builder.CreateAdd(i, DtoConstUint(1));
+  i->addIncoming(next, loopbb);
+  builder.CreateCondBr(builder.CreateICmpULT(next, DtoConstUint(numPairs)),
+                       loopbb, endbb);
+
+  builder.SetInsertPoint(endbb);
+  builder.CreateRetVoid();
+
+  // Run it after all other shared static destructors of this module (which
+  // may still execute instrumented code). The ModuleInfo imports rt.cover to
+  // make sure this happens before the report is written, see
+  // buildImportedModules().
+  {
+    FuncDeclaration *fd =
+        FuncDeclaration::genCfunc(nullptr, Type::tvoid, dtorname);
+    fd->linkage = LINKd;
+    IrFunction *irfunc = getIrFunc(fd, true);
+    irfunc->setLLVMFunc(dtor);
+    irm->sharedDtors.push_back(fd);
+  }
+
+  IF_LOG Logger::undent();
+}
+
 // Initialize _d_cover_valid for coverage analysis
 void addCoverageAnalysisInitializer(Module *m) {
   IF_LOG Logger::println("Adding coverage analysis _d_cover_valid initializer");
@@ -731,6 +849,10 @@ void codegenModule(IRState *irs, Module *m) {
     fatal();
   }
 
+  if (m->d_cover_valid) {
+    addCoverageAnalysisBlockCounters(m);
+  }
+
   // Skip emission of all the additional module metadata if requested by the
   // user or the betterC switch is on.
   if (!global.params.betterC && !m->noModuleInfo) {
@@ -26,6 +26,41 @@ static unsigned getVthisIdx(AggregateDeclaration *ad) {
 
 static void DtoCreateNestedContextType(FuncDeclaration *fd);
 
+/// Returns the frame of the enclosing function at the given nesting depth,
+/// loaded only once per function from the incoming context, or null if not
+/// available.
+static LLValue *getOuterFrame(FuncGenState &funcGen, unsigned depth) {
+  auto &frames = funcGen.outerFrames;
+  if (depth >= frames.size()) {
+    return nullptr;
+  }
+
+  if (!frames[depth]) {
+    // The frame lists are immutable, so the frame pointer can be loaded right
+    // after the context at function entry, dominating all uses.
+    auto ctx = llvm::dyn_cast<llvm::Instruction>(frames.back());
+    if (!ctx) {
+      return nullptr;
+    }
+    LLValue *indices[] = {DtoConstUint(0), DtoConstUint(depth)};
+    llvm::GetElementPtrInst *gep;
+    llvm::LoadInst *frame;
+    if (auto insertBefore = ctx->getNextNode()) {
+      gep = llvm::GetElementPtrInst::CreateInBounds(ctx, indices, "",
+                                                    insertBefore);
+      frame = new llvm::LoadInst(gep, ".frame", insertBefore);
+    } else {
+      gep = llvm::GetElementPtrInst::CreateInBounds(ctx, indices, "",
+                                                    ctx->getParent());
+      frame = new llvm::LoadInst(gep, ".frame", ctx->getParent());
+    }
+    frame->setAlignment(getABITypeAlign(frame->getType()));
+    frames[depth] = frame;
+  }
+
+  return frames[depth];
+}
+
 DValue *DtoNestedVariable(Loc &loc, Type *astype, VarDeclaration *vd,
                           bool byref) {
   IF_LOG Logger::println("DtoNestedVariable for %s @ %s", vd->toChars(),
@@ -104,7 +139,10 @@ DValue *DtoNestedVariable(Loc &loc, Type *astype, VarDeclaration *vd,
     Logger::cout() << "Function depth: " << funcdepth << '\n';
   }
 
-  if (vardepth == funcdepth) {
+  if (LLValue *frame = getOuterFrame(gIR->funcGen(), vardepth)) {
+    IF_LOG Logger::println("Using frame loaded at function entry");
+    val = frame;
+  } else if (vardepth == funcdepth) {
     // This is not always handled above because functions without
     // variables accessed by nested functions don't create new frames.
     IF_LOG Logger::println("Same depth");
@@ -146,7 +184,7 @@ DValue *DtoNestedVariable(Loc &loc, Type *astype, VarDeclaration *vd,
     }
   }
 
-  if (!skipDIDeclaration && global.params.symdebug) {
+  if (!skipDIDeclaration && gIR->DBuilder.mustEmitFullDebugInfo()) {
     // Because we are passing a GEP instead of an alloca to
     // llvm.dbg.declare, we have to make the address dereference explicit.
     gIR->DBuilder.OpDeref(dwarfAddrOps);
@@ -283,6 +321,8 @@ LLValue *DtoNestedContext(Loc &loc, Dsymbol *sym) {
       // fd needs the same context as we do, so all is well
       IF_LOG Logger::println(
           "Calling sibling function or directly nested function");
+    } else if (LLValue *frame = getOuterFrame(funcGen, neededDepth)) {
+      val = frame;
     } else {
       val = DtoBitCast(val,
                        LLPointerType::getUnqual(getIrFunc(ctxfd)->frameType));
@@ -413,6 +453,29 @@ void DtoCreateNestedContext(FuncGenState &funcGen) {
 
   DtoCreateNestedContextType(fd);
 
+  // Load the incoming context once; the frames of further enclosing functions
+  // are then loaded from it on demand (see getOuterFrame()).
+  {
+    auto &irFunc = funcGen.irFunc;
+    const unsigned depth = irFunc.depth;
+    LLType *ctxType = nullptr;
+    unsigned ctxDepth = 0;
+    if (fd->closureVars.dim > 0) {
+      if (depth != 0) {
+        ctxType = irFunc.frameType->getContainedType(depth - 1);
+        ctxDepth = depth - 1;
+      }
+    } else if (irFunc.frameType) {
+      ctxType = LLPointerType::getUnqual(irFunc.frameType);
+      ctxDepth = depth;
+    }
+    if (ctxType && irFunc.nestArg) {
+      funcGen.outerFrames.resize(ctxDepth + 1);
+      funcGen.outerFrames[ctxDepth] =
+          DtoBitCast(DtoLoad(irFunc.nestArg), ctxType, ".context");
+    }
+  }
+
   // construct nested variables array
   if (fd->closureVars.dim > 0) {
     auto &irFunc = funcGen.irFunc;
@@ -499,7 +562,7 @@ void DtoCreateNestedContext(FuncGenState &funcGen) {
         irLocal->value = gep;
       }
 
-      if (global.params.symdebug) {
+      if (gIR->DBuilder.mustEmitFullDebugInfo()) {
 #if LDC_LLVM_VER >= 306
         LLSmallVector<int64_t, 2> addr;
 #else
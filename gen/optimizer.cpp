@@ -141,6 +141,16 @@ bool willCrossModuleInline() {
 
 bool isOptimizationEnabled() { return optimizeLevel != 0; }
 
+bool mayUseTypeInfoMetadata() {
+  // Only the GarbageCollect2Stack pass uses it, possibly in a later LTO or
+  // bitcode optimization run.
+  if (disableLangSpecificPasses || disableGCToStack) {
+    return false;
+  }
+  return (optLevel() >= 2 && sizeLevel() == 0) || opts::isUsingLTO() ||
+         global.params.output_bc;
+}
+
 llvm::CodeGenOpt::Level codeGenOptLevel() {
   // Use same appoach as clang (see lib/CodeGen/BackendUtil.cpp)
   if (optLevel() == 0) {
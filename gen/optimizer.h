@@ -39,6 +39,10 @@ unsigned optLevel();
 
 bool isOptimizationEnabled();
 
+// Returns whether the optimizer may make use of the TypeInfo metadata emitted
+// for the types used in a module.
+bool mayUseTypeInfoMetadata();
+
 llvm::CodeGenOpt::Level codeGenOptLevel();
 
 void verifyModule(llvm::Module *m);
@@ -31,7 +31,9 @@
 #include "llvm/IR/CFG.h"
 #include "llvm/IR/InlineAsm.h"
 #include <fstream>
+#include <map>
 #include <math.h>
+#include <set>
 #include <stdio.h>
 
 // Need to include this after the other DMD includes because of missing
@@ -50,6 +52,129 @@ namespace {
 bool compareCaseStrings(CaseStatement *lhs, CaseStatement *rhs) {
   return lhs->exp->compare(rhs->exp) < 0;
 }
+
+/// Emits an inline lookup of a string in the constant cases of a string
+/// switch, replacing the _d_switch_* druntime calls. It dispatches on the
+/// length first, then on the characters distinguishing the remaining
+/// candidates (trie-like), and finally verifies the single candidate left
+/// using memcmp.
+class StringSwitchLookup {
+public:
+  struct Candidate {
+    StringExp *str;
+    unsigned index; // in the sorted cases
+  };
+
+  StringSwitchLookup(IRState &irs, Type *charType)
+      : irs(irs), charTy(DtoType(charType)),
+        charSize(getTypeAllocSize(charTy)) {}
+
+  /// Returns the index of the matching case or -1 (i32).
+  LLValue *emit(DValue *str, llvm::ArrayRef<Candidate> candidates) {
+    ptr = DtoArrayPtr(str);
+    const auto len = DtoArrayLen(str);
+
+    auto &b = *irs.ir;
+    auto startBB = irs.scopebb();
+    resultBB = irs.insertBBAfter(startBB, "stringswitch.result");
+    noMatchBB = irs.insertBBAfter(startBB, "stringswitch.nomatch");
+
+    irs.scope() = IRScope(resultBB);
+    result = b.CreatePHI(LLType::getInt32Ty(irs.context()), 8,
+                         "stringswitch.index");
+
+    // Dispatch on the length.
+    std::map<size_t, llvm::SmallVector<Candidate, 4>> byLength;
+    for (const auto &c : candidates) {
+      byLength[c.str->len].push_back(c);
+    }
+    irs.scope() = IRScope(startBB);
+    auto si = b.CreateSwitch(len, noMatchBB, byLength.size());
+    for (auto &group : byLength) {
+      auto bb = irs.insertBBBefore(noMatchBB, "stringswitch.length");
+      si->addCase(isaConstantInt(DtoConstSize_t(group.first)), bb);
+      irs.scope() = IRScope(bb);
+      emitDispatch(group.second, group.first);
+    }
+
+    irs.scope() = IRScope(noMatchBB);
+    result->addIncoming(DtoConstInt(-1), noMatchBB);
+    b.CreateBr(resultBB);
+
+    irs.scope() = IRScope(resultBB);
+    return result;
+  }
+
+private:
+  IRState &irs;
+  LLType *const charTy;
+  const uint64_t charSize;
+
+  LLValue *ptr = nullptr;
+  llvm::BasicBlock *resultBB = nullptr;
+  llvm::BasicBlock *noMatchBB = nullptr;
+  llvm::PHINode *result = nullptr;
+
+  /// Dispatches among candidates of the given length in the current block.
+  void emitDispatch(llvm::ArrayRef<Candidate> candidates, size_t length) {
+    if (candidates.size() == 1) {
+      emitVerification(candidates[0], length);
+      return;
+    }
+
+    // Find the position with the most distinct characters.
+    size_t bestPos = 0;
+    size_t bestCount = 0;
+    for (size_t pos = 0; pos < length; ++pos) {
+      std::set<unsigned> chars;
+      for (const auto &c : candidates) {
+        chars.insert(c.str->charAt(pos));
+      }
+      if (chars.size() > bestCount) {
+        bestPos = pos;
+        bestCount = chars.size();
+      }
+    }
+    // The cases are distinct, so some position has to tell them apart.
+    assert(bestCount > 1);
+
+    std::map<unsigned, llvm::SmallVector<Candidate, 4>> byChar;
+    for (const auto &c : candidates) {
+      byChar[c.str->charAt(bestPos)].push_back(c);
+    }
+
+    auto &b = *irs.ir;
+    const auto charPtr = DtoGEPi1(ptr, bestPos);
+    const auto ch = DtoLoad(charPtr, "stringswitch.char");
+    auto si = b.CreateSwitch(ch, noMatchBB, byChar.size());
+    for (auto &group : byChar) {
+      auto bb = irs.insertBBBefore(noMatchBB, "stringswitch.char");
+      si->addCase(llvm::ConstantInt::get(
+                      llvm::cast<llvm::IntegerType>(charTy), group.first),
+                  bb);
+      irs.scope() = IRScope(bb);
+      emitDispatch(group.second, length);
+    }
+  }
+
+  /// Compares the string to the single candidate left.
+  void emitVerification(const Candidate &c, size_t length) {
+    auto &b = *irs.ir;
+    const auto index = DtoConstInt(c.index);
+    if (length == 0) {
+      result->addIncoming(index, irs.scopebb());
+      b.CreateBr(resultBB);
+      return;
+    }
+
+    const auto casePtr = toConstElem(c.str, &irs)->getAggregateElement(1u);
+    const auto cmp = DtoMemCmp(ptr, casePtr, DtoConstSize_t(length * charSize));
+    const auto isEqual =
+        b.CreateICmpEQ(cmp, DtoConstInt(0), "stringswitch.equal");
+    result->addIncoming(index, irs.scopebb());
+    b.CreateCondBr(isEqual, resultBB, noMatchBB);
+  }
+};
 }
 
 static LLValue *call_string_switch_runtime(llvm::Value *table, Expression *e) {
@@ -906,8 +1031,10 @@ public:
     indices.reserve(caseCount);
     bool useSwitchInst = true;
 
-    // For string switches, sort the cases and emit the table data.
+    // For string switches, sort the cases and emit the table data (unless
+    // the lookup is done inline).
     llvm::Value *stringTableSlice = nullptr;
+    llvm::SmallVector<StringSwitchLookup::Candidate, 16> stringCandidates;
     const bool isStringSwitch = !stmt->condition->type->isintegral();
     if (isStringSwitch) {
       Logger::println("is string switch");
@@ -917,12 +1044,24 @@ public:
       cases = cases->copy();
       std::sort(cases->begin(), cases->end(), compareCaseStrings);
 
+      for (size_t i = 0; i < caseCount; ++i) {
+        indices.push_back(DtoConstUint(i));
+        const auto e = (*cases)[i]->exp;
+        if (e->op == TOKstring) {
+          stringCandidates.push_back(
+              {static_cast<StringExp *>(e), static_cast<unsigned>(i)});
+        }
+      }
+    }
+    const bool inlineStringLookup =
+        isStringSwitch && stringCandidates.size() == caseCount;
+
+    if (isStringSwitch && !inlineStringLookup) {
       // Emit constants for the case values.
       llvm::SmallVector<llvm::Constant *, 16> stringConsts;
       stringConsts.reserve(caseCount);
       for (size_t i = 0; i < caseCount; ++i) {
         stringConsts.push_back(toConstElem((*cases)[i]->exp, irs));
-        indices.push_back(DtoConstUint(i));
       }
 
       // Create internal global with the data table.
@@ -938,7 +1077,7 @@ public:
           llvm::ConstantExpr::getBitCast(arr, getPtrToType(elemTy));
       const auto arrLen = DtoConstSize_t(stringConsts.size());
       stringTableSlice = DtoConstSlice(arrLen, arrPtr);
-    } else {
+    } else if (!isStringSwitch) {
       for (auto cs : *cases) {
         if (cs->exp->op == TOKvar) {
           const auto vd =
@@ -983,7 +1122,12 @@ public:
     if (useSwitchInst) {
       // The case index value.
       LLValue *condVal;
-      if (isStringSwitch) {
+      if (inlineStringLookup) {
+        Type *charType =
+            stmt->condition->type->toBasetype()->nextOf()->toBasetype();
+        StringSwitchLookup lookup(*irs, charType);
+        condVal = lookup.emit(toElemDtor(stmt->condition), stringCandidates);
+      } else if (isStringSwitch) {
         condVal = call_string_switch_runtime(stringTableSlice, stmt->condition);
       } else {
         condVal = DtoRVal(toElemDtor(stmt->condition));
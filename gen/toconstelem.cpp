@@ -158,7 +158,6 @@ public:
     LOG_SCOPE;
 
     Type *const t = e->type->toBasetype();
-    Type *const cty = t->nextOf()->toBasetype();
 
     auto _init = buildStringLiteralConstant(e, t->ty != Tsarray);
 
@@ -167,24 +166,7 @@ public:
       return;
     }
 
-    auto stringLiteralCache = stringLiteralCacheForType(cty);
-    llvm::StringRef key(e->toChars());
-    llvm::GlobalVariable *gvar =
-        (stringLiteralCache->find(key) == stringLiteralCache->end())
-            ? nullptr
-            : (*stringLiteralCache)[key];
-    if (gvar == nullptr) {
-      llvm::GlobalValue::LinkageTypes _linkage =
-          llvm::GlobalValue::PrivateLinkage;
-      gvar = new llvm::GlobalVariable(gIR->module, _init->getType(), true,
-                                      _linkage, _init, ".str");
-#if LDC_LLVM_VER >= 309
-      gvar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
-#else
-      gvar->setUnnamedAddr(true);
-#endif
-      (*stringLiteralCache)[key] = gvar;
-    }
+    llvm::GlobalVariable *gvar = gIR->getPooledConstant(_init, ".str");
 
     llvm::ConstantInt *zero =
         LLConstantInt::get(LLType::getInt32Ty(gIR->context()), 0, false);
@@ -542,15 +524,12 @@ public:
     }
 
     bool canBeConst = e->type->isConst() || e->type->isImmutable();
-    auto gvar = new llvm::GlobalVariable(
-        gIR->module, initval->getType(), canBeConst,
-        llvm::GlobalValue::InternalLinkage, initval, ".dynarrayStorage");
-#if LDC_LLVM_VER >= 309
-    gvar->setUnnamedAddr(canBeConst ? llvm::GlobalValue::UnnamedAddr::Global
-                                    : llvm::GlobalValue::UnnamedAddr::None);
-#else
-    gvar->setUnnamedAddr(canBeConst);
-#endif
+    llvm::GlobalVariable *gvar =
+        canBeConst ? gIR->getPooledConstant(initval, ".dynarrayStorage")
+                   : new llvm::GlobalVariable(
+                         gIR->module, initval->getType(), false,
+                         llvm::GlobalValue::InternalLinkage, initval,
+                         ".dynarrayStorage");
     llvm::Constant *store = DtoBitCast(gvar, getPtrToType(arrtype));
 
     if (bt->ty == Tpointer) {
@@ -384,33 +384,15 @@ public:
 
     LLType *ct = DtoMemType(cty);
 
-    llvm::StringMap<llvm::GlobalVariable *> *stringLiteralCache =
-        stringLiteralCacheForType(cty);
     LLConstant *_init = buildStringLiteralConstant(e, true);
     const auto at = _init->getType();
-
-    llvm::StringRef key(e->toChars());
-    llvm::GlobalVariable *gvar =
-        (stringLiteralCache->find(key) == stringLiteralCache->end())
-            ? nullptr
-            : (*stringLiteralCache)[key];
-    if (gvar == nullptr) {
-      llvm::GlobalValue::LinkageTypes _linkage =
-          llvm::GlobalValue::PrivateLinkage;
-      IF_LOG {
-        Logger::cout() << "type: " << *at << '\n';
-        Logger::cout() << "init: " << *_init << '\n';
-      }
-      gvar = new llvm::GlobalVariable(gIR->module, at, true, _linkage, _init,
-                                      ".str");
-#if LDC_LLVM_VER >= 309
-      gvar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
-#else
-      gvar->setUnnamedAddr(true);
-#endif
-      (*stringLiteralCache)[key] = gvar;
+    IF_LOG {
+      Logger::cout() << "type: " << *at << '\n';
+      Logger::cout() << "init: " << *_init << '\n';
     }
 
+    llvm::GlobalVariable *gvar = gIR->getPooledConstant(_init, ".str");
+
     llvm::ConstantInt *zero =
         LLConstantInt::get(LLType::getInt32Ty(gIR->context()), 0, false);
     LLConstant *idxs[2] = {zero, zero};
@@ -2269,9 +2251,7 @@ public:
     } else if (dyn) {
       if (arrayType->isImmutable() && isConstLiteral(e, true)) {
         llvm::Constant *init = arrayLiteralToConst(p, e);
-        auto global = new llvm::GlobalVariable(
-            gIR->module, init->getType(), true,
-            llvm::GlobalValue::InternalLinkage, init, ".immutablearray");
+        auto global = gIR->getPooledConstant(init, ".immutablearray");
         result = new DSliceValue(arrayType, DtoConstSize_t(len),
                                  DtoBitCast(global, getPtrToType(llElemType)));
       } else {
@@ -443,23 +443,9 @@ LLConstant *DtoConstFP(Type *t, const real_t value) {
 
 LLConstant *DtoConstString(const char *str) {
   llvm::StringRef s(str ? str : "");
-  llvm::GlobalVariable *gvar = (gIR->stringLiteral1ByteCache.find(s) ==
-                                gIR->stringLiteral1ByteCache.end())
-                                   ? nullptr
-                                   : gIR->stringLiteral1ByteCache[s];
-  if (gvar == nullptr) {
-    llvm::Constant *init =
-        llvm::ConstantDataArray::getString(gIR->context(), s, true);
-    gvar = new llvm::GlobalVariable(gIR->module, init->getType(), true,
-                                    llvm::GlobalValue::PrivateLinkage, init,
-                                    ".str");
-#if LDC_LLVM_VER >= 309
-    gvar->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
-#else
-    gvar->setUnnamedAddr(true);
-#endif
-    gIR->stringLiteral1ByteCache[s] = gvar;
-  }
+  llvm::Constant *init =
+      llvm::ConstantDataArray::getString(gIR->context(), s, true);
+  llvm::GlobalVariable *gvar = gIR->getPooledConstant(init, ".str");
   LLConstant *idxs[] = {DtoConstUint(0), DtoConstUint(0)};
   return DtoConstSlice(DtoConstSize_t(s.size()),
                        llvm::ConstantExpr::getGetElementPtr(
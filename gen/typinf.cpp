@@ -35,6 +35,7 @@
 #include "mtype.h"
 #include "scope.h"
 #include "template.h"
+#include "driver/cl_options.h"
 #include "gen/arrays.h"
 #include "gen/classes.h"
 #include "gen/irstate.h"
@@ -43,6 +44,7 @@
 #include "gen/llvmhelpers.h"
 #include "gen/logger.h"
 #include "gen/metadata.h"
+#include "gen/optimizer.h"
 #include "gen/rttibuilder.h"
 #include "gen/runtime.h"
 #include "gen/structs.h"
@@ -76,6 +78,10 @@ TypeInfoDeclaration *getOrCreateTypeInfoDeclaration(Type *torig, Scope *sc) {
 //////////////////////////////////////////////////////////////////////////////
 
 static void emitTypeMetadata(TypeInfoDeclaration *tid) {
+  if (!mayUseTypeInfoMetadata()) {
+    return;
+  }
+
   // We don't want to generate metadata for non-concrete types (such as tuple
   // types, slice types, typeof(expr), etc.), void and function types (without
   // an indirection), as there must be a valid LLVM undef value of that type.
@@ -579,6 +585,38 @@ public:
 
 /* ========================================================================= */
 
+/// Returns the module defining the struct of the given TypeInfo if that
+/// module emits it as weak_odr symbol for the other modules (-typeinfo-once),
+/// null otherwise.
+static Module *getTypeInfoOnceModule(TypeInfoDeclaration *decl) {
+  if (!opts::typeInfoInDefiningModule) {
+    return nullptr;
+  }
+
+  // Only plain TypeInfo_Struct instances are emitted by the module defining
+  // the struct (see the StructDeclaration codegen visitor).
+  Type *t = decl->tinfo;
+  if (t->ty != Tstruct || t->mod != 0) {
+    return nullptr;
+  }
+  StructDeclaration *sd = static_cast<TypeStruct *>(t)->sym;
+  if (!sd->members || DtoIsTemplateInstance(sd)) {
+    return nullptr;
+  }
+  return sd->getModule();
+}
+
+/// Returns whether the given TypeInfo is defined by another module, i.e.,
+/// only needs to be declared (-typeinfo-once).
+/// That is only guaranteed if the other module is compiled to a separate
+/// object file by this compiler invocation; libraries may have been built
+/// without -typeinfo-once and only contain a linkonce_odr definition, which
+/// can be discarded if unused there.
+static bool isDefinedInOtherModule(TypeInfoDeclaration *decl) {
+  Module *m = getTypeInfoOnceModule(decl);
+  return m && m != gIR->dmodule && m->isRoot() && !global.params.oneobj;
+}
+
 void TypeInfoDeclaration_codegen(TypeInfoDeclaration *decl, IRState *p) {
   IF_LOG Logger::println("TypeInfoDeclaration_codegen(%s)",
                          decl->toPrettyChars());
@@ -628,9 +666,23 @@ void TypeInfoDeclaration_codegen(TypeInfoDeclaration *decl, IRState *p) {
     return;
   }
 
+  // the struct's module provides the definition
+  if (isDefinedInOtherModule(decl)) {
+    Logger::println("defined in another module");
+    return;
+  }
+
   // define custom typedef
   LLVMDefineVisitor v;
   decl->accept(&v);
+
+  // Other modules only declare it, so it must not be discarded when unused
+  // here.
+  Module *m = getTypeInfoOnceModule(decl);
+  if (m && m == gIR->dmodule) {
+    setLinkage({LLGlobalValue::WeakODRLinkage, supportsCOMDAT()},
+               llvm::cast<LLGlobalVariable>(irg->value));
+  }
 }
 
 /* ========================================================================= */
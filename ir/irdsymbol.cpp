@@ -9,7 +9,10 @@
 
 #include "gen/llvm.h"
 #include "gen/logger.h"
+#include "ir/iraggr.h"
 #include "ir/irdsymbol.h"
+#include "ir/irfunction.h"
+#include "ir/irmodule.h"
 #include "ir/irvar.h"
 
 // Callbacks for constructing/destructing Dsymbol.ir member.
@@ -50,6 +53,34 @@ IrDsymbol::~IrDsymbol() {
 }
 
 void IrDsymbol::reset() {
+  // The IR data refers to the LLVM module of a previous codegen run, so free
+  // it right away instead of keeping it alive until the compiler exits.
+  switch (m_type) {
+  case NotSet:
+    break;
+  case ModuleType:
+    delete irModule;
+    break;
+  case AggrType:
+    delete irAggr;
+    break;
+  case FuncType:
+    delete irFunc;
+    break;
+  case GlobalType:
+    delete irGlobal;
+    break;
+  case LocalType:
+    delete irLocal;
+    break;
+  case ParamterType:
+    delete irParam;
+    break;
+  case FieldType:
+    delete irField;
+    break;
+  }
+
   irData = nullptr;
   m_type = Type::NotSet;
   m_state = State::Initial;
@@ -15,6 +15,8 @@
 #define LDC_IR_IRMODULE_H
 
 #include <list>
+#include <utility>
+#include <vector>
 
 class FuncDeclaration;
 class VarDeclaration;
@@ -42,6 +44,12 @@ struct IrModule {
   GatesList sharedGates;
   FuncDeclList unitTests;
 
+  // -cov-block-counters: the per-region coverage counters and the (0-based
+  // line#, counter index) pairs from which the line counts are reconstructed.
+  llvm::GlobalVariable *coverageBlockCounters = nullptr;
+  unsigned numCoverageBlockCounters = 0;
+  std::vector<std::pair<unsigned, unsigned>> coverageLineCounters;
+
 private:
   llvm::GlobalVariable *moduleInfoVar = nullptr;
 };
@@ -20,10 +20,13 @@
 // These functions use getGlobalContext() as they are invoked before gIR
 // is set.
 
+size_t IrType::numCreated = 0;
+
 IrType::IrType(Type *dt, LLType *lt) : dtype(dt), type(lt) {
   assert(dt && "null D Type");
   assert(lt && "null LLVM Type");
   assert(!dt->ctype && "already has IrType");
+  ++numCreated;
 }
 
 IrFuncTy &IrType::getIrFuncTy() {
@@ -90,6 +90,9 @@ public:
   ///
   virtual IrFuncTy &getIrFuncTy();
 
+  /// Number of IrTypes created so far (for -fmem-report).
+  static size_t numCreated;
+
 protected:
   ///
   IrType(Type *dt, llvm::Type *lt);